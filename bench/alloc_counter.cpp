@@ -0,0 +1,61 @@
+/*
+ * File: alloc_counter.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Implementation of the heap allocations counter.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 20, 2026, 04:10 AM
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "./alloc_counter.hpp"
+
+
+/////////////////////////////// Helper functions ///////////////////////////////
+
+namespace
+{
+
+/**
+ * @brief Number of heap allocations of the program.
+*/
+std::atomic<unsigned long long> allocs{0};
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+unsigned long long utils::alloc_counter::nb_allocs()
+{
+    return allocs.load(std::memory_order_relaxed);
+}
+
+
+/**
+ * @brief Replacement of the global allocation functions (the other forms of
+ * operator new and delete call these ones).
+*/
+void* operator new(std::size_t size)
+{
+    allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size > 0 ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
@@ -0,0 +1,32 @@
+/*
+ * File: alloc_counter.hpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Heap allocations counter of the microbenchmarks. The global operator
+ * new is replaced (in its own translation unit, so it is never inlined at the
+ * call sites) by a version that counts the allocations of the program.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 20, 2026, 04:05 AM
+ */
+
+#ifndef UTILS_ALLOC_COUNTER_HPP
+#define UTILS_ALLOC_COUNTER_HPP
+
+
+namespace utils
+{
+namespace alloc_counter
+{
+    /**
+    * @brief Get the number of heap allocations (calls of operator new) of the
+    * program so far.
+    * @return unsigned long long: number of allocations.
+    */
+    unsigned long long nb_allocs();
+
+} // alloc_counter
+} // utils
+
+#endif /* UTILS_ALLOC_COUNTER_HPP */
@@ -0,0 +1,387 @@
+/*
+ * File: bench.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief NISE-SPH [1] benchmark: graphs of each synthetic generator (see
+ * utils::generators) are generated at several sizes and NISE is run on them
+ * with several numbers of threads. The wall time of each phase (see
+ * Run_report) and the throughput of the loading (edges/s) and of the seed
+ * expansion (seeds/s and PPR pushes/s) are printed as a table and, optionally,
+ * written in a CSV file, so the runs can be compared to track regressions.
+ *
+ * Usage: ./nise_bench [flag] <value>, where the flags are "-g" generators
+ * ("lfr,rmat,whiskers"), "-v" numbers of vertices ("2000,8000"), "-n" numbers
+ * of threads ("1,<hardware threads>"), "-r" random seed (1), "-d" directory of
+ * the generated files ("./bench_data") and "-o" CSV file path (none).
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 20, 2026, 02:05 AM
+ *
+ * References:
+ * [1] J. J. Whang, D. F. Gleich and I. S. Dhillon. Overlapping community
+ * detection using neighborhood-inflated seed expansion, IEEE Transactions on
+ * Knowledge and Data Engineering 28(5) (2016) p. 1272-1284.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <experimental/filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../headers/nise.hpp"
+#include "../headers/nise_parameters.hpp"
+#include "../headers/time_mgmt.hpp"
+#include "./generators.hpp"
+
+
+/////////////////////////////// Helper functions ///////////////////////////////
+
+namespace
+{
+
+/**
+ * @brief Parameters of the generators for a number of vertices n: the
+ * LFR-style graphs have average degree 10, max degree 50, mixing 0.3,
+ * communities of 20 to 100 vertices and 10% of the vertices in 2 communities;
+ * the R-MAT graphs have scale log2(n), edge factor 8 and the Graph500
+ * probabilities; the whiskers graphs have a core of n/2 vertices with average
+ * degree 8 and as many vertices in whiskers of up to 32 vertices.
+*/
+const double lfr_avg_degree = 10; // magic number
+const unsigned int lfr_max_degree = 50; // magic number
+const double lfr_mixing = 0.3; // magic number
+const unsigned int lfr_min_community = 20; // magic number
+const unsigned int lfr_max_community = 100; // magic number
+const double lfr_overlapping_fraction = 0.1; // magic number
+const unsigned int lfr_overlapping_memberships = 2; // magic number
+const unsigned int rmat_edge_factor = 8; // magic number
+const double rmat_a = 0.57; // magic number
+const double rmat_b = 0.19; // magic number
+const double rmat_c = 0.19; // magic number
+const double whiskers_core_avg_degree = 8; // magic number
+const double whiskers_periphery_ratio = 1; // magic number
+const unsigned int whiskers_max_size = 32; // magic number
+
+/**
+ * @brief Number of seeds of the graphs without planted communities: one seed
+ * per this number of vertices.
+*/
+const unsigned int vertices_per_seed = 50; // magic number
+
+/**
+ * @brief Phases of the run report shown by the benchmark.
+*/
+const std::vector<std::string> phases = {"filtering", "core_graph", "seeding",
+    "expansion", "indexing", "propagation", "writing"};
+
+/**
+ * @brief Benchmark settings (see the file header).
+*/
+struct settings
+{
+    std::vector<std::string> generators = {"lfr", "rmat", "whiskers"};
+    std::vector<unsigned int> sizes = {2000, 8000};
+    std::vector<unsigned int> threads;
+    std::uint64_t seed = 1;
+    std::string dir = "./bench_data";
+    std::string csv_path;
+};
+
+/**
+ * @brief Split a comma separated list.
+*/
+std::vector<std::string> split(const std::string &str)
+{
+    std::vector<std::string> items;
+    std::istringstream ss(str);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+/**
+ * @brief Parse a comma separated list of positive integers.
+ * @return bool: true if all the items are positive integers.
+*/
+bool parse_uints(const std::string &str, std::vector<unsigned int> &vals)
+{
+    vals.clear();
+    for (const auto &item : split(str))
+    {
+        try
+        {
+            const long val = std::stol(item);
+            if (val < 1)
+            {
+                return false;
+            }
+            vals.push_back(static_cast<unsigned int>(val));
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+    return !vals.empty();
+}
+
+/**
+ * @brief Set the benchmark settings from the terminal user input.
+ * @return bool: true if all the flags and values are valid.
+*/
+bool set_settings(const int argc, char** argv, settings &s)
+{
+    const unsigned int hw = std::max(1u, std::thread::hardware_concurrency());
+    s.threads = hw > 1 ? std::vector<unsigned int>{1, hw} :
+        std::vector<unsigned int>{1};
+    if ((argc - 1) % 2 != 0)
+    {
+        return false;
+    }
+    for (int i = 1; i < argc; i += 2)
+    {
+        const std::string flag = argv[i];
+        const std::string val = argv[i + 1];
+        if (flag == "-g")
+        {
+            s.generators = split(val);
+            for (const auto &g : s.generators)
+            {
+                if (g != "lfr" && g != "rmat" && g != "whiskers")
+                {
+                    return false;
+                }
+            }
+        }
+        else if (flag == "-v")
+        {
+            if (!parse_uints(val, s.sizes) || *std::min_element(
+                s.sizes.begin(), s.sizes.end()) < lfr_max_community)
+            {
+                return false;
+            }
+        }
+        else if (flag == "-n")
+        {
+            if (!parse_uints(val, s.threads))
+            {
+                return false;
+            }
+        }
+        else if (flag == "-r")
+        {
+            try
+            {
+                s.seed = std::stoull(val);
+            }
+            catch (...)
+            {
+                return false;
+            }
+        }
+        else if (flag == "-d")
+        {
+            s.dir = val;
+        }
+        else if (flag == "-o")
+        {
+            s.csv_path = val;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return !s.generators.empty() && !s.dir.empty();
+}
+
+/**
+ * @brief Generate a graph of a generator with about n vertices.
+ * @param const std::string &: generator name.
+ * @param const unsigned int: number of vertices.
+ * @param const std::uint64_t: random seed.
+ * @return utils::generators::generated_graph: graph.
+*/
+utils::generators::generated_graph generate(const std::string &generator,
+    const unsigned int n, const std::uint64_t seed)
+{
+    if (generator == "lfr")
+    {
+        return utils::generators::lfr(n, lfr_avg_degree, lfr_max_degree,
+            lfr_mixing, lfr_min_community, lfr_max_community,
+            lfr_overlapping_fraction, lfr_overlapping_memberships, seed);
+    }
+    else if (generator == "rmat")
+    {
+        const unsigned int scale = static_cast<unsigned int>(
+            std::lround(std::log2(n)));
+        return utils::generators::rmat(scale, rmat_edge_factor, rmat_a, rmat_b,
+            rmat_c, seed);
+    }
+    return utils::generators::whiskers(n / 2, whiskers_core_avg_degree,
+        whiskers_periphery_ratio, whiskers_max_size, seed);
+}
+
+/**
+ * @brief Run NISE on a graph with a number of threads and a number of seeds
+ * (the default alpha and epsilon). The standard output of the run is
+ * discarded.
+ * @param const Graph &: graph.
+ * @param const std::string &: output clustering file path.
+ * @param const unsigned int: number of seeds.
+ * @param const unsigned int: number of threads.
+ * @param std::map<std::string, double> &: output wall time of each phase and
+ * the throughput of the seed expansion.
+*/
+void run_nise(const Graph &g, const std::string &output_path,
+    const unsigned int nb_seeds, const unsigned int nb_threads,
+    std::map<std::string, double> &results)
+{
+    Nise_parameters params;
+    if (!params.set_configuration({params.alpha(), params.epsilon(),
+        nb_seeds}) || !params.set("-n", std::to_string(nb_threads)) ||
+        !params.set("-o", output_path))
+    {
+        std::cerr << "[ERROR] run_nise: invalid parameters.\n";
+        exit(EXIT_FAILURE);
+    }
+
+    std::ofstream null_stream; // not opened: the output is discarded
+    std::streambuf *cout_buffer = std::cout.rdbuf(null_stream.rdbuf());
+    Nise nise(g, params);
+    nise.execute();
+    nise.write_clustering();
+    std::cout.rdbuf(cout_buffer);
+
+    for (const auto &p : phases)
+    {
+        results[p] = nise.get_report().get_wall_time(p);
+    }
+    const double expansion_time = results["expansion"];
+    results["seeds_per_sec"] = expansion_time > 0 ?
+        nise.get_nb_expansions() / expansion_time : 0;
+    results["pushes_per_sec"] = expansion_time > 0 ?
+        nise.get_nb_pushes() / expansion_time : 0;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+int main(int argc, char** argv)
+{
+    settings s;
+    if (!set_settings(argc, argv, s))
+    {
+        std::cerr << "[ERROR] Wrong parameter. See the bench/bench.cpp file "
+            "header.\n";
+        return EXIT_FAILURE;
+    }
+    std::experimental::filesystem::create_directories(s.dir);
+
+    std::ofstream csv;
+    if (!s.csv_path.empty())
+    {
+        csv.open(s.csv_path, std::fstream::trunc);
+        if (!csv)
+        {
+            std::cerr << "[ERROR] It was not possible to open " << s.csv_path
+                << ".\n";
+            return EXIT_FAILURE;
+        }
+        csv << "generator,nb_vertices,nb_edges,threads,load_edges_per_sec";
+        for (const auto &p : phases)
+        {
+            csv << "," << p << "_sec";
+        }
+        csv << ",seeds_per_sec,pushes_per_sec\n";
+    }
+
+    std::printf("%-9s %8s %9s %3s %12s", "graph", "n", "m", "thr",
+        "load(e/s)");
+    for (const auto &p : phases)
+    {
+        std::printf(" %13s", (p + "(s)").c_str());
+    }
+    std::printf(" %12s %12s\n", "seeds/s", "pushes/s");
+
+    for (const auto &generator : s.generators)
+    {
+        for (const auto n : s.sizes)
+        {
+            const auto gen = generate(generator, n, s.seed);
+            const std::string name = generator + "_" + std::to_string(n) +
+                "_" + std::to_string(s.seed);
+            const std::string graph_path = s.dir + "/" + name + ".lfi";
+            if (!utils::generators::write_graph(gen, graph_path) ||
+                (!gen.communities.empty() && !utils::generators::
+                write_communities(gen, s.dir + "/" + name + ".cmty")))
+            {
+                std::cerr << "[ERROR] It was not possible to write " <<
+                    graph_path << ".\n";
+                return EXIT_FAILURE;
+            }
+            const unsigned int nb_seeds = gen.communities.empty() ?
+                std::max(1u, gen.nb_vertices / vertices_per_seed) :
+                static_cast<unsigned int>(gen.communities.size());
+
+            // the graph loading is single threaded: it is measured once
+            std::ofstream null_stream;
+            std::streambuf *cout_buffer = std::cout.rdbuf(null_stream.rdbuf());
+            utils::time_mgmt tmgmt;
+            tmgmt.start();
+            Graph g(graph_path);
+            tmgmt.end();
+            std::cout.rdbuf(cout_buffer);
+            const double load_rate = g.get_nb_edges() /
+                std::max(tmgmt.get_total_time_in_sec(), 1e-9);
+
+            for (const auto nb_threads : s.threads)
+            {
+                std::map<std::string, double> results;
+                run_nise(g, s.dir + "/" + name + ".clustering.dat",
+                    nb_seeds, nb_threads, results);
+
+                std::printf("%-9s %8u %9u %3u %12.4g", generator.c_str(),
+                    g.get_nb_vertices(), g.get_nb_edges(), nb_threads,
+                    load_rate);
+                for (const auto &p : phases)
+                {
+                    std::printf(" %13.4f", results[p]);
+                }
+                std::printf(" %12.4g %12.4g\n", results["seeds_per_sec"],
+                    results["pushes_per_sec"]);
+                std::fflush(stdout);
+
+                if (csv.is_open())
+                {
+                    csv << generator << "," << g.get_nb_vertices() << "," <<
+                        g.get_nb_edges() << "," << nb_threads << "," <<
+                        load_rate;
+                    for (const auto &p : phases)
+                    {
+                        csv << "," << results[p];
+                    }
+                    csv << "," << results["seeds_per_sec"] << "," <<
+                        results["pushes_per_sec"] << "\n";
+                }
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,498 @@
+/*
+ * File: generators.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Implementation of the synthetic graph generators of the benchmark.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 20, 2026, 01:25 AM
+ *
+ * References:
+ * [1] A. Lancichinetti and S. Fortunato. Benchmarks for testing community
+ * detection algorithms on directed and weighted graphs with overlapping
+ * communities, Physical Review E 80(1) (2009) 016118.
+ * [2] D. Chakrabarti, Y. Zhan and C. Faloutsos. R-MAT: A recursive model for
+ * graph mining. In: Proceedings of the 2004 SIAM International Conference on
+ * Data Mining. SIAM, 2004.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include "./generators.hpp"
+
+
+/////////////////////////////// Helper functions ///////////////////////////////
+
+namespace
+{
+
+/**
+ * @brief Exponents of the degrees and of the communities sizes power laws
+ * (see [1]).
+*/
+const double degree_exponent = 2; // magic number
+const double community_exponent = 1; // magic number
+
+/**
+ * @brief Number of quantiles used to compute the mean of a power law.
+*/
+const unsigned int nb_quantiles = 1000; // magic number
+
+/**
+ * @brief Number of tries to swap a vertex that is already in the community
+ * being filled with another membership slot (LFR-style generator).
+*/
+const unsigned int max_swap_tries = 16; // magic number
+
+typedef std::vector<std::pair<unsigned int, unsigned int>> edge_list;
+
+/**
+ * @brief Continuous power law on [min, max] with the given exponent by the
+ * inverse of its cumulative distribution function.
+ * @param const double: min value.
+ * @param const double: max value.
+ * @param const double: exponent.
+ * @param const double: cumulative probability in [0, 1].
+ * @return double: value.
+*/
+double power_law_quantile(const double min, const double max,
+    const double exponent, const double u)
+{
+    if (exponent == 1)
+    {
+        return min * std::pow(max / min, u);
+    }
+    const double e = 1 - exponent;
+    return std::pow((std::pow(max, e) - std::pow(min, e)) * u +
+        std::pow(min, e), 1 / e);
+}
+
+/**
+ * @brief Mean of the power law (see power_law_quantile) computed by its
+ * quantiles.
+*/
+double power_law_mean(const double min, const double max,
+    const double exponent)
+{
+    double sum = 0;
+    for (unsigned int i = 0; i < nb_quantiles; ++i)
+    {
+        sum += power_law_quantile(min, max, exponent, (i + 0.5) / nb_quantiles);
+    }
+    return sum / nb_quantiles;
+}
+
+/**
+ * @brief Draw an integer from the power law (see power_law_quantile).
+*/
+unsigned int power_law_sample(std::mt19937_64 &rng, const double min,
+    const double max, const double exponent)
+{
+    std::uniform_real_distribution<double> uniform(0, 1);
+    return static_cast<unsigned int>(std::lround(
+        power_law_quantile(min, max, exponent, uniform(rng))));
+}
+
+/**
+ * @brief Pair the stubs at random (configuration model): the stubs are
+ * shuffled and consecutive stubs are linked.
+ * @param std::vector<unsigned int> &: stubs (a vertex appears once per stub).
+ * @param std::mt19937_64 &: random number generator.
+ * @param edge_list &: output edges (appended).
+*/
+void pair_stubs(std::vector<unsigned int> &stubs, std::mt19937_64 &rng,
+    edge_list &edges)
+{
+    std::shuffle(stubs.begin(), stubs.end(), rng);
+    for (std::size_t i = 0; i + 1 < stubs.size(); i += 2)
+    {
+        edges.emplace_back(stubs[i], stubs[i + 1]);
+    }
+}
+
+/**
+ * @brief Normalize the edges to (u, v) with u < v, drop the loops and the
+ * repeated edges and sort them.
+*/
+void normalize(edge_list &edges)
+{
+    for (auto &e : edges)
+    {
+        if (e.first > e.second)
+        {
+            std::swap(e.first, e.second);
+        }
+    }
+    edges.erase(std::remove_if(edges.begin(), edges.end(),
+        [](const std::pair<unsigned int, unsigned int> &e)
+        {
+            return e.first == e.second;
+        }), edges.end());
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+}
+
+/**
+ * @brief Relabel the vertices of a graph by a random permutation. The
+ * vertices flagged as unused are dropped and the others are renumbered from 0.
+ * @param utils::generators::generated_graph &: graph.
+ * @param const std::vector<bool> &: flag of each used vertex.
+ * @param std::mt19937_64 &: random number generator.
+*/
+void relabel(utils::generators::generated_graph &g,
+    const std::vector<bool> &used, std::mt19937_64 &rng)
+{
+    std::vector<unsigned int> new_ids;
+    for (unsigned int v = 0; v < g.nb_vertices; ++v)
+    {
+        if (used[v])
+        {
+            new_ids.push_back(static_cast<unsigned int>(new_ids.size()));
+        }
+    }
+    std::shuffle(new_ids.begin(), new_ids.end(), rng);
+
+    std::vector<unsigned int> id(g.nb_vertices, 0);
+    for (unsigned int v = 0, i = 0; v < g.nb_vertices; ++v)
+    {
+        if (used[v])
+        {
+            id[v] = new_ids[i++];
+        }
+    }
+
+    for (auto &e : g.edges)
+    {
+        e = std::make_pair(id[e.first], id[e.second]);
+    }
+    for (auto &c : g.communities)
+    {
+        for (auto &v : c)
+        {
+            v = id[v];
+        }
+        std::sort(c.begin(), c.end());
+    }
+    g.nb_vertices = static_cast<unsigned int>(new_ids.size());
+    normalize(g.edges);
+}
+
+/**
+ * @brief Append an unsigned integer and a separator to a buffer.
+*/
+void append(std::string &buffer, const unsigned int val, const char sep)
+{
+    char str[16];
+    char *end = std::to_chars(str, str + sizeof(str), val).ptr;
+    *end++ = sep;
+    buffer.append(str, end);
+}
+
+/**
+ * @brief Write a buffer in a file.
+*/
+bool write_buffer(const std::string &buffer, const std::string &path)
+{
+    std::ofstream f(path, std::ios::binary | std::fstream::trunc);
+    f.write(buffer.data(), buffer.size());
+    f.close();
+    return static_cast<bool>(f);
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+utils::generators::generated_graph utils::generators::lfr(
+    const unsigned int nb_vertices, const double avg_degree,
+    const unsigned int max_degree, const double mixing,
+    const unsigned int min_community, const unsigned int max_community,
+    const double overlapping_fraction,
+    const unsigned int overlapping_memberships, const std::uint64_t seed)
+{
+    assert(nb_vertices > 1 && avg_degree >= 1 && max_degree >= avg_degree);
+    assert(min_community > 1 && max_community >= min_community);
+    std::mt19937_64 rng(seed);
+    generated_graph g{nb_vertices, {}, {}};
+
+    // the min degree is set so the degrees mean is the average degree
+    double lo = 1;
+    double hi = max_degree;
+    for (unsigned int i = 0; i < 64; ++i) // bisection
+    {
+        const double mid = (lo + hi) / 2;
+        if (power_law_mean(mid, max_degree, degree_exponent) < avg_degree)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    std::vector<unsigned int> degree(nb_vertices);
+    for (auto &d : degree)
+    {
+        d = std::max(1u, power_law_sample(rng, lo, max_degree,
+            degree_exponent));
+    }
+
+    // the overlapping vertices are chosen at random
+    std::vector<unsigned int> memberships(nb_vertices, 1);
+    std::vector<unsigned int> order(nb_vertices);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+    const unsigned int nb_overlapping = static_cast<unsigned int>(
+        std::lround(overlapping_fraction * nb_vertices));
+    for (unsigned int i = 0; i < nb_overlapping; ++i)
+    {
+        memberships[order[i]] = std::max(1u, overlapping_memberships);
+    }
+
+    // membership slots shared out to communities of power law sizes
+    std::vector<unsigned int> slots;
+    for (unsigned int v = 0; v < nb_vertices; ++v)
+    {
+        slots.insert(slots.end(), memberships[v], v);
+    }
+    std::shuffle(slots.begin(), slots.end(), rng);
+
+    std::vector<unsigned int> in_community(nb_vertices,
+        static_cast<unsigned int>(-1)); // last community of each vertex
+    std::size_t next = 0;
+    while (next < slots.size())
+    {
+        std::size_t size = std::min<std::size_t>(slots.size() - next,
+            power_law_sample(rng, min_community, max_community,
+            community_exponent));
+        if (slots.size() - next - size < min_community) // last community
+        {
+            size = slots.size() - next;
+        }
+        const unsigned int c = static_cast<unsigned int>(g.communities.size());
+        g.communities.emplace_back();
+        for (std::size_t i = next; i < next + size; ++i)
+        {
+            // a vertex with several slots may fall twice in a community
+            for (unsigned int t = 0; t < max_swap_tries &&
+                in_community[slots[i]] == c && i + 1 < slots.size(); ++t)
+            {
+                std::uniform_int_distribution<std::size_t> pick(i + 1,
+                    slots.size() - 1);
+                std::swap(slots[i], slots[pick(rng)]);
+            }
+            if (in_community[slots[i]] != c)
+            {
+                in_community[slots[i]] = c;
+                g.communities.back().push_back(slots[i]);
+            }
+        }
+        next += size;
+    }
+
+    // internal edges: configuration model inside each community
+    std::vector<unsigned int> internal(nb_vertices, 0);
+    for (const auto &c : g.communities)
+    {
+        std::vector<unsigned int> stubs;
+        for (auto v : c)
+        {
+            const double share = (1 - mixing) * degree[v] / memberships[v];
+            const unsigned int k = std::min(static_cast<unsigned int>(
+                c.size() - 1), std::max(1u, static_cast<unsigned int>(
+                std::lround(share))));
+            stubs.insert(stubs.end(), k, v);
+            internal[v] += k;
+        }
+        pair_stubs(stubs, rng, g.edges);
+    }
+
+    // external edges: configuration model over the whole graph
+    std::vector<unsigned int> stubs;
+    for (unsigned int v = 0; v < nb_vertices; ++v)
+    {
+        if (degree[v] > internal[v])
+        {
+            stubs.insert(stubs.end(), degree[v] - internal[v], v);
+        }
+    }
+    pair_stubs(stubs, rng, g.edges);
+    normalize(g.edges);
+
+    // vertices left without edges are linked to a random vertex
+    std::vector<bool> has_edge(nb_vertices, false);
+    for (const auto &e : g.edges)
+    {
+        has_edge[e.first] = has_edge[e.second] = true;
+    }
+    std::uniform_int_distribution<unsigned int> pick(0, nb_vertices - 1);
+    for (unsigned int v = 0; v < nb_vertices; ++v)
+    {
+        if (!has_edge[v])
+        {
+            unsigned int u = pick(rng);
+            g.edges.emplace_back(v, u != v ? u : (v + 1) % nb_vertices);
+        }
+    }
+    normalize(g.edges);
+
+    for (auto &c : g.communities)
+    {
+        std::sort(c.begin(), c.end());
+    }
+    return g;
+}
+
+
+utils::generators::generated_graph utils::generators::rmat(
+    const unsigned int scale, const unsigned int edge_factor, const double a,
+    const double b, const double c, const std::uint64_t seed)
+{
+    assert(scale > 0 && scale < 32 && a + b + c <= 1);
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    generated_graph g{1u << scale, {}, {}};
+
+    const std::size_t nb_edges =
+        static_cast<std::size_t>(edge_factor) * g.nb_vertices;
+    g.edges.reserve(nb_edges);
+    for (std::size_t i = 0; i < nb_edges; ++i)
+    {
+        unsigned int u = 0;
+        unsigned int v = 0;
+        for (unsigned int bit = 1u << (scale - 1); bit > 0; bit >>= 1)
+        {
+            const double r = uniform(rng);
+            if (r >= a + b + c) // quadrant d
+            {
+                u |= bit;
+                v |= bit;
+            }
+            else if (r >= a + b) // quadrant c
+            {
+                u |= bit;
+            }
+            else if (r >= a) // quadrant b
+            {
+                v |= bit;
+            }
+        }
+        g.edges.emplace_back(u, v);
+    }
+    normalize(g.edges);
+
+    std::vector<bool> used(g.nb_vertices, false);
+    for (const auto &e : g.edges)
+    {
+        used[e.first] = used[e.second] = true;
+    }
+    relabel(g, used, rng);
+    return g;
+}
+
+
+utils::generators::generated_graph utils::generators::whiskers(
+    const unsigned int core_size, const double avg_degree,
+    const double periphery_ratio, const unsigned int max_whisker_size,
+    const std::uint64_t seed)
+{
+    assert(core_size > 2 && avg_degree >= 2 && max_whisker_size > 0);
+    std::mt19937_64 rng(seed);
+    const unsigned int nb_whisker_vtx = static_cast<unsigned int>(
+        std::lround(periphery_ratio * core_size));
+    generated_graph g{core_size + nb_whisker_vtx, {}, {}};
+
+    // biconnected core: a ring plus random chords
+    std::uniform_int_distribution<unsigned int> core_vtx(0, core_size - 1);
+    for (unsigned int v = 0; v < core_size; ++v)
+    {
+        g.edges.emplace_back(v, (v + 1) % core_size);
+    }
+    const std::size_t nb_chords = static_cast<std::size_t>(
+        (avg_degree - 2) * core_size / 2);
+    for (std::size_t i = 0; i < nb_chords; ++i)
+    {
+        g.edges.emplace_back(core_vtx(rng), core_vtx(rng));
+    }
+
+    // whiskers: random trees attached to the core by a bridge
+    std::uniform_int_distribution<unsigned int> whisker_size(1,
+        max_whisker_size);
+    unsigned int next = core_size;
+    while (next < g.nb_vertices)
+    {
+        const unsigned int root = next;
+        const unsigned int size = std::min(whisker_size(rng),
+            g.nb_vertices - next);
+        g.edges.emplace_back(core_vtx(rng), root);
+        for (unsigned int v = root + 1; v < root + size; ++v)
+        {
+            std::uniform_int_distribution<unsigned int> parent(root, v - 1);
+            g.edges.emplace_back(parent(rng), v);
+        }
+        next += size;
+    }
+    normalize(g.edges);
+
+    relabel(g, std::vector<bool>(g.nb_vertices, true), rng);
+    return g;
+}
+
+
+bool utils::generators::write_graph(const generated_graph &g,
+    const std::string &path)
+{
+    // adjacency lists in compressed sparse row format (both directions)
+    std::vector<std::size_t> offset(g.nb_vertices + 1, 0);
+    for (const auto &e : g.edges)
+    {
+        ++offset[e.first + 1];
+        ++offset[e.second + 1];
+    }
+    std::partial_sum(offset.begin(), offset.end(), offset.begin());
+    std::vector<unsigned int> adj(offset.back());
+    std::vector<std::size_t> cursor(offset.begin(), offset.end() - 1);
+    for (const auto &e : g.edges) // edges are sorted, so the rows are too
+    {
+        adj[cursor[e.first]++] = e.second;
+    }
+    for (const auto &e : g.edges)
+    {
+        adj[cursor[e.second]++] = e.first;
+    }
+
+    std::string buffer;
+    append(buffer, g.nb_vertices, '\n');
+    for (unsigned int v = 0; v < g.nb_vertices; ++v)
+    {
+        std::sort(adj.begin() + offset[v], adj.begin() + offset[v + 1]);
+        for (std::size_t i = offset[v]; i < offset[v + 1]; ++i)
+        {
+            append(buffer, v, '\t');
+            append(buffer, adj[i], '\n');
+        }
+    }
+    return write_buffer(buffer, path);
+}
+
+
+bool utils::generators::write_communities(const generated_graph &g,
+    const std::string &path)
+{
+    std::string buffer;
+    for (const auto &c : g.communities)
+    {
+        for (std::size_t i = 0; i < c.size(); ++i)
+        {
+            append(buffer, c[i], i + 1 < c.size() ? ' ' : '\n');
+        }
+    }
+    return write_buffer(buffer, path);
+}
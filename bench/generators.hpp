@@ -0,0 +1,133 @@
+/*
+ * File: generators.hpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Synthetic graph generators of the benchmark: LFR-style graphs with
+ * planted overlapping communities [1], R-MAT (Kronecker) graphs [2] and
+ * graphs with large whisker peripheries [3]. All of them are seeded, so a
+ * (generator, parameters, seed) triple always yields the same graph.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 20, 2026, 01:10 AM
+ *
+ * References:
+ * [1] A. Lancichinetti and S. Fortunato. Benchmarks for testing community
+ * detection algorithms on directed and weighted graphs with overlapping
+ * communities, Physical Review E 80(1) (2009) 016118.
+ * [2] D. Chakrabarti, Y. Zhan and C. Faloutsos. R-MAT: A recursive model for
+ * graph mining. In: Proceedings of the 2004 SIAM International Conference on
+ * Data Mining. SIAM, 2004.
+ * [3] J. Leskovec, K. J. Lang, A. Dasgupta and M. W. Mahoney. Community
+ * structure in large networks: natural cluster sizes and the absence of large
+ * well-defined clusters, Internet Mathematics 6(1) (2009) p. 29-123.
+ */
+
+#ifndef UTILS_GENERATORS_HPP
+#define UTILS_GENERATORS_HPP
+
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace utils
+{
+namespace generators
+{
+    /**
+    * @brief Generated graph: number of vertices, undirected edges (u, v) with
+    * u < v, sorted and without repetitions, and the planted communities (only
+    * by the LFR-style generator).
+    */
+    struct generated_graph
+    {
+        unsigned int nb_vertices;
+        std::vector<std::pair<unsigned int, unsigned int>> edges;
+        std::vector<std::vector<unsigned int>> communities;
+    };
+
+    /**
+    * @brief LFR-style graph with planted overlapping communities (see [1]).
+    * The degrees and the communities sizes follow power laws (exponents 2 and
+    * 1); a fraction of the vertices belong to several communities. Each vertex
+    * links a fraction 1 - mixing of its edges inside its communities and the
+    * others at random, by the configuration model. Unlike [1], the repeated
+    * edges and loops are dropped instead of rewired, so the degrees are only
+    * approximately the planted ones.
+    * @param const unsigned int: number of vertices.
+    * @param const double: average degree.
+    * @param const unsigned int: maximum degree.
+    * @param const double: mixing parameter in [0, 1].
+    * @param const unsigned int: minimum community size.
+    * @param const unsigned int: maximum community size.
+    * @param const double: fraction of overlapping vertices in [0, 1].
+    * @param const unsigned int: number of communities of each overlapping
+    * vertex.
+    * @param const std::uint64_t: random seed.
+    * @return generated_graph: graph and its planted communities.
+    */
+    generated_graph lfr(const unsigned int nb_vertices,
+        const double avg_degree, const unsigned int max_degree,
+        const double mixing, const unsigned int min_community,
+        const unsigned int max_community, const double overlapping_fraction,
+        const unsigned int overlapping_memberships, const std::uint64_t seed);
+
+    /**
+    * @brief R-MAT graph (see [2]): each edge falls recursively in one of the
+    * four quadrants of the adjacency matrix with probabilities a, b, c and
+    * 1 - a - b - c. The loops, the repeated edges and the isolated vertices are
+    * dropped and the vertices are randomly relabeled, so the ids carry no
+    * locality.
+    * @param const unsigned int: scale (the matrix has 2^scale rows).
+    * @param const unsigned int: edge factor (edges sampled per row).
+    * @param const double: a.
+    * @param const double: b.
+    * @param const double: c.
+    * @param const std::uint64_t: random seed.
+    * @return generated_graph: graph (without communities).
+    */
+    generated_graph rmat(const unsigned int scale,
+        const unsigned int edge_factor, const double a, const double b,
+        const double c, const std::uint64_t seed);
+
+    /**
+    * @brief Graph with a large whisker periphery (see [3]): a biconnected core
+    * (a ring plus random chords) and random trees, each one attached to a
+    * random core vertex by a bridge. The vertices are randomly relabeled.
+    * @param const unsigned int: number of core vertices.
+    * @param const double: average degree of the core.
+    * @param const double: number of whisker vertices per core vertex.
+    * @param const unsigned int: maximum whisker size.
+    * @param const std::uint64_t: random seed.
+    * @return generated_graph: graph (without communities).
+    */
+    generated_graph whiskers(const unsigned int core_size,
+        const double avg_degree, const double periphery_ratio,
+        const unsigned int max_whisker_size, const std::uint64_t seed);
+
+    /**
+    * @brief Write a graph in the input format of the Graph class: the number
+    * of vertices in the first line and then one line "v u" per edge in each
+    * direction, sorted by v.
+    * @param const generated_graph &: graph.
+    * @param const std::string &: output file path.
+    * @return bool: true if the file was written, false otherwise.
+    */
+    bool write_graph(const generated_graph &g, const std::string &path);
+
+    /**
+    * @brief Write the planted communities in the clustering file format: one
+    * line per community with its vertices separated by spaces.
+    * @param const generated_graph &: graph.
+    * @param const std::string &: output file path.
+    * @return bool: true if the file was written, false otherwise.
+    */
+    bool write_communities(const generated_graph &g, const std::string &path);
+
+} // generators
+} // utils
+
+#endif /* UTILS_GENERATORS_HPP */
@@ -0,0 +1,499 @@
+/*
+ * File: microbench.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Microbenchmarks of the Graph, Cluster and Clustering primitives and of
+ * the sweep step (see utils::sweep) on graphs of each synthetic generator (see
+ * utils::generators), so each primitive has a baseline independent of the full
+ * runs. Each benchmark is repeated and the best time per operation (ns/op) is
+ * reported with the number of heap allocations per operation (see
+ * utils::alloc_counter).
+ *
+ * Usage: ./nise_microbench [flag] <value>, where the flags are "-g" generators
+ * ("lfr,rmat,whiskers"), "-v" number of vertices (10000), "-r" random seed
+ * (1), "-k" number of repetitions (5) and "-o" CSV file path (none).
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 20, 2026, 03:40 AM
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../headers/cluster.hpp"
+#include "../headers/clustering.hpp"
+#include "../headers/graph.hpp"
+#include "../headers/sweep.hpp"
+#include "./alloc_counter.hpp"
+#include "./generators.hpp"
+
+
+/////////////////////////////// Helper functions ///////////////////////////////
+
+namespace
+{
+
+/**
+ * @brief Clusters of the Cluster and Clustering benchmarks and sweep orders of
+ * the sweep benchmark: breadth-first balls of up to ball_size vertices around
+ * nb_balls random vertices.
+*/
+const unsigned int nb_balls = 256; // magic number
+const unsigned int ball_size = 64; // magic number
+
+/**
+ * @brief Generators parameters (see bench.cpp).
+*/
+const double lfr_avg_degree = 10; // magic number
+const unsigned int lfr_max_degree = 50; // magic number
+const double lfr_mixing = 0.3; // magic number
+const unsigned int lfr_min_community = 20; // magic number
+const unsigned int lfr_max_community = 100; // magic number
+const double lfr_overlapping_fraction = 0.1; // magic number
+const unsigned int lfr_overlapping_memberships = 2; // magic number
+const unsigned int rmat_edge_factor = 8; // magic number
+const double rmat_a = 0.57; // magic number
+const double rmat_b = 0.19; // magic number
+const double rmat_c = 0.19; // magic number
+const double whiskers_core_avg_degree = 8; // magic number
+const double whiskers_periphery_ratio = 1; // magic number
+const unsigned int whiskers_max_size = 32; // magic number
+
+/**
+ * @brief Microbenchmark settings (see the file header).
+*/
+struct settings
+{
+    std::vector<std::string> generators = {"lfr", "rmat", "whiskers"};
+    unsigned int size = 10000;
+    std::uint64_t seed = 1;
+    unsigned int reps = 5;
+    std::string csv_path;
+};
+
+/**
+ * @brief Result of a benchmark: name, unit of operation, number of
+ * operations, best time per operation and heap allocations per operation.
+*/
+struct result
+{
+    std::string name;
+    std::string op;
+    unsigned long long nb_ops;
+    double ns_per_op;
+    double allocs_per_op;
+};
+
+/**
+ * @brief The results of the benchmarks are accumulated in it, so the
+ * optimizer can not discard the measured code.
+*/
+volatile unsigned long long sink = 0;
+
+/**
+ * @brief Split a comma separated list.
+*/
+std::vector<std::string> split(const std::string &str)
+{
+    std::vector<std::string> items;
+    std::istringstream ss(str);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+/**
+ * @brief Set the microbenchmark settings from the terminal user input.
+ * @return bool: true if all the flags and values are valid.
+*/
+bool set_settings(const int argc, char** argv, settings &s)
+{
+    if ((argc - 1) % 2 != 0)
+    {
+        return false;
+    }
+    for (int i = 1; i < argc; i += 2)
+    {
+        const std::string flag = argv[i];
+        const std::string val = argv[i + 1];
+        try
+        {
+            if (flag == "-g")
+            {
+                s.generators = split(val);
+                for (const auto &g : s.generators)
+                {
+                    if (g != "lfr" && g != "rmat" && g != "whiskers")
+                    {
+                        return false;
+                    }
+                }
+            }
+            else if (flag == "-v" && std::stol(val) >= lfr_max_community)
+            {
+                s.size = static_cast<unsigned int>(std::stol(val));
+            }
+            else if (flag == "-r")
+            {
+                s.seed = std::stoull(val);
+            }
+            else if (flag == "-k" && std::stol(val) > 0)
+            {
+                s.reps = static_cast<unsigned int>(std::stol(val));
+            }
+            else if (flag == "-o")
+            {
+                s.csv_path = val;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+    return !s.generators.empty();
+}
+
+/**
+ * @brief Generate a graph of a generator with about n vertices.
+*/
+utils::generators::generated_graph generate(const std::string &generator,
+    const unsigned int n, const std::uint64_t seed)
+{
+    if (generator == "lfr")
+    {
+        return utils::generators::lfr(n, lfr_avg_degree, lfr_max_degree,
+            lfr_mixing, lfr_min_community, lfr_max_community,
+            lfr_overlapping_fraction, lfr_overlapping_memberships, seed);
+    }
+    else if (generator == "rmat")
+    {
+        const unsigned int scale = static_cast<unsigned int>(
+            std::lround(std::log2(n)));
+        return utils::generators::rmat(scale, rmat_edge_factor, rmat_a, rmat_b,
+            rmat_c, seed);
+    }
+    return utils::generators::whiskers(n / 2, whiskers_core_avg_degree,
+        whiskers_periphery_ratio, whiskers_max_size, seed);
+}
+
+/**
+ * @brief Run a benchmark: setup (not measured) and run are called reps times.
+ * @param const std::string &: benchmark name.
+ * @param const std::string &: unit of operation.
+ * @param const unsigned long long: number of operations of each run.
+ * @param const unsigned int: number of repetitions.
+ * @param Setup &&: setup of each run.
+ * @param Run &&: run.
+ * @return result: best time per operation and allocations per operation.
+*/
+template <class Setup, class Run>
+result measure(const std::string &name, const std::string &op,
+    const unsigned long long nb_ops, const unsigned int reps, Setup &&setup,
+    Run &&run)
+{
+    double best = std::numeric_limits<double>::infinity();
+    unsigned long long allocs = 0;
+    for (unsigned int i = 0; i < reps; ++i)
+    {
+        setup();
+        const unsigned long long allocs_before =
+            utils::alloc_counter::nb_allocs();
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const auto end = std::chrono::steady_clock::now();
+        allocs = utils::alloc_counter::nb_allocs() - allocs_before;
+        best = std::min(best, std::chrono::duration<double, std::nano>(
+            end - start).count());
+    }
+    const double ops = static_cast<double>(std::max(1ull, nb_ops));
+    return {name, op, nb_ops, best / ops, allocs / ops};
+}
+
+/**
+ * @brief Breadth-first ball of up to ball_size vertices around a vertex.
+*/
+std::vector<unsigned int> bfs_ball(const Graph &g, const unsigned int v,
+    std::vector<bool> &visited)
+{
+    std::vector<unsigned int> ball = {v};
+    visited[v] = true;
+    for (std::size_t i = 0; i < ball.size() && ball.size() < ball_size; ++i)
+    {
+        auto adj = g.adj_list_of_vtx(ball[i]);
+        for (auto it = adj.first; it != adj.second &&
+            ball.size() < ball_size; ++it)
+        {
+            if (!visited[*it])
+            {
+                visited[*it] = true;
+                ball.push_back(*it);
+            }
+        }
+    }
+    for (auto u : ball)
+    {
+        visited[u] = false;
+    }
+    return ball;
+}
+
+/**
+ * @brief Run all the benchmarks on a generated graph.
+ * @param const utils::generators::generated_graph &: graph.
+ * @param const unsigned int: number of repetitions.
+ * @param const std::uint64_t: random seed.
+ * @return std::vector<result>: result of each benchmark.
+*/
+std::vector<result> run_benchmarks(
+    const utils::generators::generated_graph &gen, const unsigned int reps,
+    const std::uint64_t seed)
+{
+    std::vector<result> results;
+    std::mt19937_64 rng(seed);
+    const unsigned int n = gen.nb_vertices;
+    const unsigned long long m = gen.edges.size();
+
+    // Graph::add_edge (adjacency list and matrix, as loaded from a file)
+    std::unique_ptr<Graph> g;
+    results.push_back(measure("graph_add_edge", "edge", m, reps,
+        [&]()
+        {
+            g.reset();
+            g = std::make_unique<Graph>(n);
+        },
+        [&]()
+        {
+            for (const auto &e : gen.edges)
+            {
+                g->add_edge(e.first, e.second);
+            }
+        }));
+
+    // Graph::has_edge: as many present edges as random pairs
+    std::vector<std::pair<unsigned int, unsigned int>> queries(
+        gen.edges.begin(), gen.edges.end());
+    std::uniform_int_distribution<unsigned int> vtx(0, n - 1);
+    for (unsigned long long i = 0; i < m; ++i)
+    {
+        queries.emplace_back(vtx(rng), vtx(rng));
+    }
+    std::shuffle(queries.begin(), queries.end(), rng);
+    results.push_back(measure("graph_has_edge", "query", queries.size(), reps,
+        []() {},
+        [&]()
+        {
+            unsigned long long hits = 0;
+            for (const auto &q : queries)
+            {
+                hits += g->has_edge(q.first, q.second);
+            }
+            sink = sink + hits;
+        }));
+
+    // Graph::adj_list_of_vtx iteration over all vertices
+    results.push_back(measure("graph_adj_iteration", "neighbor", 2 * m, reps,
+        []() {},
+        [&]()
+        {
+            unsigned long long sum = 0;
+            for (unsigned int v = 0; v < n; ++v)
+            {
+                auto adj = g->adj_list_of_vtx(v);
+                for (auto it = adj.first; it != adj.second; ++it)
+                {
+                    sum += *it;
+                }
+            }
+            sink = sink + sum;
+        }));
+
+    // clusters: breadth-first balls, their vertices in random order
+    std::vector<std::vector<unsigned int>> balls;
+    std::vector<bool> visited(n, false);
+    unsigned long long nb_members = 0;
+    for (unsigned int i = 0; i < nb_balls; ++i)
+    {
+        balls.push_back(bfs_ball(*g, vtx(rng), visited));
+        nb_members += balls.back().size();
+    }
+    std::vector<std::vector<unsigned int>> shuffled = balls;
+    for (auto &b : shuffled)
+    {
+        std::shuffle(b.begin(), b.end(), rng);
+    }
+
+    // Cluster::insert without and with the degrees bookkeeping
+    std::vector<Cluster> clusters;
+    for (const bool degrees : {false, true})
+    {
+        results.push_back(measure(degrees ? "cluster_insert_degrees" :
+            "cluster_insert", "vertex", nb_members, reps,
+            [&]()
+            {
+                clusters.clear();
+                for (unsigned int i = 0; i < nb_balls; ++i)
+                {
+                    clusters.emplace_back(*g);
+                    if (degrees)
+                    {
+                        sink = sink + clusters.back().get_external_degree();
+                    }
+                }
+            },
+            [&]()
+            {
+                for (unsigned int i = 0; i < nb_balls; ++i)
+                {
+                    for (auto v : shuffled[i])
+                    {
+                        clusters[i].insert(v);
+                    }
+                }
+            }));
+    }
+
+    // Cluster::remove (degrees computed)
+    results.push_back(measure("cluster_remove_degrees", "vertex", nb_members,
+        reps,
+        [&]()
+        {
+            clusters.clear();
+            for (unsigned int i = 0; i < nb_balls; ++i)
+            {
+                clusters.emplace_back(*g, balls[i]);
+                sink = sink + clusters.back().get_external_degree();
+            }
+        },
+        [&]()
+        {
+            for (unsigned int i = 0; i < nb_balls; ++i)
+            {
+                for (auto v : shuffled[i])
+                {
+                    clusters[i].remove(v);
+                }
+            }
+        }));
+
+    // Clustering::insert one cluster at a time and in bulk
+    std::unique_ptr<Clustering> clustering;
+    auto setup_clusters = [&]()
+        {
+            clustering.reset();
+            clustering = std::make_unique<Clustering>(n);
+            clusters.clear();
+            for (unsigned int i = 0; i < nb_balls; ++i)
+            {
+                clusters.emplace_back(*g, balls[i]);
+            }
+        };
+    results.push_back(measure("clustering_insert", "cluster", nb_balls, reps,
+        setup_clusters,
+        [&]()
+        {
+            for (const auto &c : clusters)
+            {
+                clustering->insert(c);
+            }
+        }));
+    results.push_back(measure("clustering_bulk_insert", "cluster", nb_balls,
+        reps, setup_clusters,
+        [&]()
+        {
+            clustering->insert(std::move(clusters));
+        }));
+
+    // sweep step on the breadth-first orders (the graph is its own core)
+    std::vector<unsigned int> identity(n);
+    std::iota(identity.begin(), identity.end(), 0);
+    results.push_back(measure("clst_min_conductance", "sweep vertex",
+        nb_members, reps, []() {},
+        [&]()
+        {
+            double min_cond;
+            for (const auto &b : balls)
+            {
+                sink = sink + utils::sweep::clst_min_conductance(*g, *g,
+                    identity, b, min_cond).size();
+            }
+        }));
+
+    return results;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+int main(int argc, char** argv)
+{
+    settings s;
+    if (!set_settings(argc, argv, s))
+    {
+        std::cerr << "[ERROR] Wrong parameter. See the bench/microbench.cpp "
+            "file header.\n";
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream csv;
+    if (!s.csv_path.empty())
+    {
+        csv.open(s.csv_path, std::fstream::trunc);
+        if (!csv)
+        {
+            std::cerr << "[ERROR] It was not possible to open " << s.csv_path
+                << ".\n";
+            return EXIT_FAILURE;
+        }
+        csv << "generator,nb_vertices,nb_edges,benchmark,op,nb_ops,ns_per_op,"
+            "allocs_per_op\n";
+    }
+
+    std::printf("%-9s %8s %9s %-24s %-13s %10s %10s %10s\n", "graph", "n", "m",
+        "benchmark", "op", "ops", "ns/op", "allocs/op");
+    for (const auto &generator : s.generators)
+    {
+        const auto gen = generate(generator, s.size, s.seed);
+        for (const auto &r : run_benchmarks(gen, s.reps, s.seed))
+        {
+            std::printf("%-9s %8u %9zu %-24s %-13s %10llu %10.2f %10.3f\n",
+                generator.c_str(), gen.nb_vertices, gen.edges.size(),
+                r.name.c_str(), r.op.c_str(), r.nb_ops, r.ns_per_op,
+                r.allocs_per_op);
+            if (csv.is_open())
+            {
+                csv << generator << "," << gen.nb_vertices << "," <<
+                    gen.edges.size() << "," << r.name << "," << r.op << "," <<
+                    r.nb_ops << "," << r.ns_per_op << "," << r.allocs_per_op <<
+                    "\n";
+            }
+        }
+        std::fflush(stdout);
+    }
+
+    return EXIT_SUCCESS;
+}
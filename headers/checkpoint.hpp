@@ -0,0 +1,80 @@
+/*
+ * File: checkpoint.hpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Checkpoint of a NISE [1] run. It persists the filtering phase output
+ * (biconnected core flags and bridges), the expanded seeds and the clusters so
+ * that a later run on the same graph with a larger number of seeds only
+ * expands the new seeds.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 03:40 PM
+ *
+ * References:
+ * [1] J. J. Whang, D. F. Gleich and I. S. Dhillon. Overlapping community
+ * detection using neighborhood-inflated seed expansion, IEEE Transactions on
+ * Knowledge and Data Engineering 28(5) (2016) p. 1272-1284.
+ */
+
+#ifndef NISE_CHECKPOINT_HPP
+#define NISE_CHECKPOINT_HPP
+
+
+#include <string>
+#include <vector>
+#include "./graph.hpp"
+
+
+struct Nise_checkpoint
+{
+    /**
+    * @brief Number of vertices and edges of the graph of the run. They are
+    * used to check that the checkpoint belongs to the input graph.
+    */
+    unsigned int nb_vertices = 0;
+    unsigned int nb_edges = 0;
+
+    /**
+    * @brief NISE parameters of the run. Clusters are reusable only if they
+    * were expanded with the same parameters.
+    */
+    double alpha = 0;
+    double epsilon = 0;
+    unsigned int seeding_method = 0;
+
+    /**
+    * @brief Filtering phase output: flag vector of the vertices of the
+    * original graph contained in the biconnected core and bridges edges.
+    */
+    std::vector<bool> contained_in_bcore;
+    std::vector<Graph::edge> bridges;
+
+    /**
+    * @brief Expanded seeds (biconnected core graph indices) in seeding order.
+    */
+    std::vector<unsigned int> seeds;
+
+    /**
+    * @brief Clusters (original graph indices) after the propagation phase.
+    */
+    std::vector<std::vector<unsigned int>> clusters;
+
+    /**
+    * @brief Read the checkpoint from a binary file.
+    * @param const std::string &: checkpoint file path.
+    * @return bool: true if the file exists and it is a valid checkpoint,
+    * false otherwise.
+    */
+    bool read(const std::string &path);
+
+    /**
+    * @brief Write the checkpoint in a binary file. The file is written in a
+    * temporary file which is renamed at the end, so an interrupted write does
+    * not corrupt a previous checkpoint.
+    * @param const std::string &: checkpoint file path.
+    */
+    void write(const std::string &path) const;
+};
+
+#endif /* NISE_CHECKPOINT_HPP */
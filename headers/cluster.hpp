@@ -22,7 +22,9 @@
 
 
 #include <cassert>
-#include <unordered_set>
+#include <cstdint>
+#include <utility>
+#include <vector>
 #include "./graph.hpp"
 
 
@@ -45,6 +47,27 @@ public:
     */
     Cluster(const Graph &g);
 
+    /**
+     * Constructor: creates the cluster with the given vertices at once (the
+     * vector is sorted and the repeated vertices are discarded), which is
+     * cheaper than inserting them one by one in an arbitrary order.
+     * @param Graph: input graph reference.
+     * @param std::vector<unsigned int>: vertices indices.
+    */
+    Cluster(const Graph &g, std::vector<unsigned int> vertices);
+
+    /**
+     * @brief Copy constructor. The degrees counters are not copied (they are
+     * computed again on demand), so a stored copy does not keep them.
+    */
+    Cluster(const Cluster &other);
+
+    /**
+     * @brief Default move constructor (the declared destructor would suppress
+     * the implicit one and moves would copy the vertices).
+    */
+    Cluster(Cluster &&other) = default;
+
     /**
      * @brief Default destructor.
     */
@@ -99,68 +122,48 @@ public:
     Cluster& operator+=(const Cluster &rhs);
 
     /**
-     * @brief Get the begin iterator of the unordered set that holds cluster's 
-     * vertices.
-     * @return std::unordered_set<unsigned int>::iterator: begin iterator. 
-    */
-    std::unordered_set<unsigned int>::iterator begin();
-    // std::vector<unsigned int>::iterator begin();
-
-    /**
-     * @brief Get the begin const iterator of the unordered set that holds 
+     * @brief Get the begin const iterator of the sorted vector that holds 
      * cluster's vertices.
-     * @return std::unordered_set<unsigned int>::iterator: begin const iterator.
-    */
-    std::unordered_set<unsigned int>::const_iterator begin() const;
-    // std::vector<unsigned int>::const_iterator begin() const;
-
-    /**
-     * @brief Get the end iterator of the unordered set that holds cluster's 
-     * vertices.
-     * @return std::unordered_set<unsigned int>::iterator: end iterator.
+     * @return std::vector<unsigned int>::const_iterator: begin const iterator.
     */
-    std::unordered_set<unsigned int>::iterator end();
-    // std::vector<unsigned int>::iterator end();
+    std::vector<unsigned int>::const_iterator begin() const;
 
     /**
-     * @brief Get the end const iterator of the unordered set that holds 
+     * @brief Get the end const iterator of the sorted vector that holds 
      * cluster's vertices.
-     * @return std::unordered_set<unsigned int>::iterator: end const iterator.
+     * @return std::vector<unsigned int>::const_iterator: end const iterator.
     */
-    std::unordered_set<unsigned int>::const_iterator end() const;
-    // std::vector<unsigned int>::const_iterator end() const;
+    std::vector<unsigned int>::const_iterator end() const;
 
     /**
-     * @brief Check if vertex v is contained in this cluster.
+     * @brief Check if vertex v is contained in this cluster: a bitmap lookup
+     * for the large clusters (see bitmap_ratio) and a binary search of the
+     * vertices vector otherwise.
      * @param unsigned int: .
      * @return bool: true if it is contained, false otherwise.
     */
     bool contains(const unsigned int v) const;
 
     /**
-     * @brief Check if the cluster is empty. The empty() method of the 
-     * std::unordered_set "m_vertices_set" is called.
+     * @brief Check if the cluster is empty.
      * @return bool: true if cluster is empty, false otherwise.
     */
     bool empty() const;
 
     /**
-     * @brief Get the begin and the end const iterators of the vector that holds
-     * the vertices that are not contained in the cluster and have at least one 
-     * adjacent vertex that is inside the cluster.
-     * @return std::pair: pair of the begin and the end const iterators.
+     * @brief Get the vertices that are not contained in the cluster and have at
+     * least one adjacent vertex that is inside the cluster. They are computed 
+     * on demand (see compute_degrees()).
+     * @return std::vector<unsigned int>: sorted external adjacent vertices.
     */
-    std::pair<
-        std::unordered_set<unsigned int>::const_iterator,
-        std::unordered_set<unsigned int>::const_iterator
-        >
-    get_external_adj_vertices() const;
+    std::vector<unsigned int> get_external_adj_vertices() const;
 
     /**
      * @brief Get the external degree of the cluster, i. e., the number of 
      * adjacencies of vertices from this cluster with vertices not contained in 
      * this cluster. In other words, the number of inter-cluster edges that have 
-     * exactly one end-point in this cluster. 
+     * exactly one end-point in this cluster. It is computed on demand (see 
+     * compute_degrees()).
      * @return unsigned int: external degree of this cluster.
     */
     unsigned int get_external_degree() const;
@@ -170,11 +173,20 @@ public:
      * cluster. Note that this number is twice the number of intra-cluster 
      * edges. 
      * The internal degree can also be seen as the sum of vertices degrees when 
-     * considering only adjacencies of vertices contained in this cluster.
+     * considering only adjacencies of vertices contained in this cluster. It 
+     * is computed on demand (see compute_degrees()).
      * @return unsigned int: internal degree of this cluster.
     */
     unsigned int get_internal_degree() const;
 
+    /**
+     * @brief Get the fingerprint of the cluster: a 64-bit hash of its vertices
+     * set that does not depend on the insertion order. Equal clusters have 
+     * equal fingerprints (see Clustering::contains()).
+     * @return std::uint64_t: fingerprint.
+    */
+    std::uint64_t get_fingerprint() const;
+
     /**
      * @brief Get the volume of the cluster, i.d., the sum of cluster's 
      * vertices' degree.
@@ -183,19 +195,31 @@ public:
     unsigned int get_volume() const;
 
     /**
-     * @brief Insert the vertex v in this cluster. This vertex is inserted in 
-     * the vertices set (unordered set m_vertices_set) and the flag of 
-     * "m_contains" is turned true.
+     * @brief Insert the vertex v in this cluster keeping the vertices vector 
+     * sorted, i.e., the vertices greater than v are shifted (inserting vertices
+     * in increasing order shifts none). If the degrees were already computed,
+     * they are updated too (see update_degrees()).
      * @param unsigned int: vertex index to be inserted.
-     * @return bool:.
+     * @return bool: true if v was inserted, false if it was already contained.
     */
     bool insert(const unsigned int v);
 
+    /**
+     * @brief Insert a batch of vertices in this cluster by a single merge of 
+     * the sorted vertices vectors. The degrees are computed again on demand.
+     * @param std::vector<unsigned int>: vertices indices to be inserted (the
+     * repeated ones are inserted once).
+     * @return unsigned int: number of vertices inserted (not contained yet).
+    */
+    unsigned int insert(std::vector<unsigned int> vertices);
+
     /**
      * @brief Checks if the vertex passed as parameter is a external adjacent 
      * vertex of this cluster. In other words, this method return true if vertex
      * v is not contained in this cluster and it has at least one adjacency with
-     * a vertex that belongs to this cluster. It returns false, otherwise.
+     * a vertex that belongs to this cluster. It returns false, otherwise. If the
+     * degrees were not computed yet, it tests the membership (see contains())
+     * of the neighbors of v until one is found.
      * @param const unsigned int: vertex.
      * @return bool: true if the vertex v is a external adjacent vertex and 
      * false otherwise.
@@ -203,25 +227,29 @@ public:
     bool is_an_external_adj_vtx(const unsigned int v) const;
 
     /**
-     * @brief Remove the vertex v from this cluster. This vertex is removed from
-     * the vertices set (unordered set m_vertices_set) and the flag of
-     * "m_contains" is turned false.
-     * @param const unsigned int
-     * @return
+     * @brief Release the external adjacent vertices counters, e.g. before the
+     * cluster is stored. The degrees are computed again on demand.
+    */
+    void release_degrees();
+
+    /**
+     * @brief Remove the vertex v from this cluster, i.e., the vertices greater
+     * than v are shifted. If the degrees were already computed, they are 
+     * updated too (see update_degrees()).
+     * @param const unsigned int: vertex index to be removed.
+     * @return bool: true if v was removed, false if it was not contained.
      */
     bool remove(const unsigned int v);
 
     /**
-     * @brief Remove the vertex v from this cluster. This vertex is removed from
-     * the vertices set (unordered set m_vertices_set) and the flag of 
-     * "m_contains" is turned false.
-     * @param const std::unordered_set<unsigned int>::const_iterator: position
+     * @brief Remove the vertex v from this cluster.
+     * @param const std::vector<unsigned int>::const_iterator: position
      * (const iterator) of the vertex to be removed.
-     * @return std::unordered_set<unsigned int>::const_iterator: next iterator
+     * @return std::vector<unsigned int>::const_iterator: next iterator
      * following the removed vertex. Returns end() if the element is not found.
     */
-    std::unordered_set<unsigned int>::const_iterator
-        remove(const std::unordered_set<unsigned int>::const_iterator it);
+    std::vector<unsigned int>::const_iterator
+        remove(const std::vector<unsigned int>::const_iterator it);
 
     /**
      * @brief Return the size of this clusters, i. e., the number of vertices 
@@ -233,6 +261,13 @@ public:
 
 private:
 
+    /**
+     * @brief A cluster keeps a bitmap of its vertices (for O(1) membership 
+     * tests) only if it has at least nb_vertices / bitmap_ratio vertices, i.e.,
+     * when the bitmap is not larger than the vertices vector itself.
+    */
+    static constexpr unsigned int bitmap_ratio = 32;
+
     /**
      * @brief enumerator used for updating internal and external degrees.
     */
@@ -246,56 +281,87 @@ private:
 
     /**
      * @brief Flag to control if internal and external degrees need to be 
-     * updated. Whenever a vertex is added or removed, this flag is set to 
-     * false.
+     * computed. Once they are computed, they are maintained by every insertion
+     * and removal.
     */
-    bool m_updated_degrees;
+    mutable bool m_updated_degrees;
 
     /**
      * @brief Internal degree of this cluster, i. e., the sum of vertices 
      * degrees belonging to this cluster considering only adjacencies between 
      * them.
     */
-    unsigned int m_internal_degree;
+    mutable unsigned int m_internal_degree;
 
     /**
      * @brief External degree of this cluster, i. e., the number of 
      * inter-cluster edges that have exactly one end-point inside this cluster. 
     */
-    unsigned int m_external_degree;
+    mutable unsigned int m_external_degree;
 
     /**
-     * @brief Cluster's vertices unordered set.
+     * @brief Fingerprint (see get_fingerprint()). It is updated by every
+     * insertion and removal.
     */
-    std::unordered_set<unsigned int> m_vertices_set;
+    std::uint64_t m_fingerprint = 0;
 
     /**
-     * @brief Cluster's adjacent vertices, i.e., vertices that are not contained
-     * in the cluster but are adjacent to at least one vertex contained in 
-     * cluster.
+     * @brief Cluster's vertices sorted in increasing order.
     */
-    std::unordered_set<unsigned int> m_ext_adj_vertices;
+    std::vector<unsigned int> m_vertices;
 
     /**
-     * @brief Compute cluster's internal and external degrees values. The 
-     * attributes m_internal_degree and m_internal_degree are updated with those
-     * values. The m_updated_degrees flag is set to true.
+     * @brief Membership bitmap indexed by vertex. It is empty for small 
+     * clusters (see bitmap_ratio).
     */
-    void compute_degrees();
+    std::vector<bool> m_bitmap;
 
     /**
-     * @brief Update cluster's internal and external degrees values.
-     * @param
-     * @param
+     * @brief Open addressing hash table (linear probing, at most half full) of
+     * pairs (external adjacent vertex, number of its adjacencies with cluster's
+     * vertices), so each counter is found in O(1) expected time without a 
+     * node allocation (see get_external_adj_vertices()). It is only filled
+     * while the degrees are maintained (see m_updated_degrees) and it is
+     * released by release_degrees().
+    */
+    mutable std::vector<std::pair<unsigned int, unsigned int>> m_ext_adj_count;
+
+    /**
+     * @brief Number of counters in m_ext_adj_count.
+    */
+    mutable unsigned int m_nb_ext_adj = 0;
+
+    /**
+     * @brief Compute cluster's internal and external degrees values if they 
+     * are outdated. The attributes m_internal_degree and m_external_degree are
+     * updated with those values, as well as the m_ext_adj_count counters. The 
+     * m_updated_degrees flag is set to true.
+    */
+    void compute_degrees() const;
+
+    /**
+     * @brief Update cluster's internal and external degrees values and the
+     * external adjacent vertices counters with integer operations only, in 
+     * O(deg(v)) expected time: each neighbor of v costs a membership test (see
+     * contains()) and a counter update. It does nothing if the degrees were 
+     * not computed yet.
+     * @param const unsigned int: inserted (already contained) or removed (still
+     * contained) vertex.
+     * @param const vertex_operation: insertion or removal.
     */
     void update_degrees(const unsigned int v, const vertex_operation op);
 
     /**
-     * @brief Update cluster's adjacent vertices.
-     * @param
-     * @param
+     * @brief Compute the fingerprint from scratch.
+    */
+    void compute_fingerprint();
+
+    /**
+     * @brief Build or release the bitmap according to the cluster size. It is
+     * released only when the size falls to half of the threshold, so 
+     * alternating insertions and removals do not rebuild it repeatedly.
     */
-    void update_adjacency(const unsigned int v, const vertex_operation op);
+    void update_bitmap();
 
 };
 
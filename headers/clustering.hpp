@@ -21,8 +21,10 @@
 #ifndef CLUSTERING_HPP
 #define CLUSTERING_HPP
 
+#include <string>
 #include <unordered_map>
 #include "./cluster.hpp"
+#include "./membership_index.hpp"
 
 
 class Clustering
@@ -41,6 +43,14 @@ public:
     */
     explicit Clustering(const unsigned int nb_vertices);
 
+    /**
+     * @brief Contructor: creates a clustering with all clusters at once (see
+     * insert(std::vector<Cluster> &&)).
+     * @param const unsigned int: graph number of vertices.
+     * @param std::vector<Cluster> &&: clusters (ids follow the vector order).
+    */
+    Clustering(const unsigned int nb_vertices, std::vector<Cluster> &&clusters);
+
     /**
      * @brief Constructor: creates a clustering from a file. This constructor is
      * used for create a ground-truth clustering
@@ -78,6 +88,16 @@ public:
     */
     bool are_all_vertices_clustered() const;
 
+    /**
+     * @brief Check if the clustering has a cluster equal to c. The candidates
+     * are found by the fingerprint index (see Cluster::get_fingerprint()), so
+     * it takes O(1) expected time plus the comparison of equal-sized clusters
+     * with the same fingerprint.
+     * @param const Cluster &: cluster.
+     * @return bool: true if an equal cluster exists, false otherwise.
+    */
+    bool contains(const Cluster &c) const;
+
     /**
      * @brief .
      * @param
@@ -86,20 +106,21 @@ public:
     const Cluster& get_cluster(const unsigned int id);
 
     /**
-     * @brief .
-     * @param
-     * @param
-     * @return
+     * @brief Get the number of vertices shared by two clusters. The overlaps 
+     * are computed on demand (see compute_ovlps()).
+     * @param const unsigned int: first cluster id.
+     * @param const unsigned int: second cluster id.
+     * @return unsigned int: intersection size.
     */
     unsigned int get_inter_size(
         const unsigned int c1_id, 
         const unsigned int c2_id) const;
 
     /**
-     * @brief .
-     * @param
-     * @param
-     * @return
+     * @brief Get the number of clusters that overlap a cluster. The overlaps 
+     * are computed on demand (see compute_ovlps()).
+     * @param const unsigned int: cluster id.
+     * @return unsigned int: number of overlapping clusters.
     */
     unsigned int get_nb_ovlp_clsts(const unsigned int c_id) const;
 
@@ -109,8 +130,8 @@ public:
      * @return
     */
     std::pair<
-        std::unordered_set<unsigned int>::const_iterator,
-        std::unordered_set<unsigned int>::const_iterator
+        std::vector<unsigned int>::const_iterator,
+        std::vector<unsigned int>::const_iterator
         >
     get_v_belonging(const unsigned int v) const;
 
@@ -122,9 +143,12 @@ public:
     unsigned int get_v_belonging_size(const unsigned int v) const;
 
     /**
-     * @brief .
-     * @param
-     * @return
+     * @brief Get the clusters that overlap a cluster and the number of 
+     * vertices shared with each one. The overlaps are computed on demand (see
+     * compute_ovlps()); the iterators are invalidated by any modification.
+     * @param const unsigned int: cluster id.
+     * @return std::pair: begin and end const iterators of the (overlapping 
+     * cluster id, intersection size) pairs.
     */
     std::pair<
         std::unordered_map<unsigned int, unsigned int>::const_iterator,
@@ -147,7 +171,17 @@ public:
     unsigned int insert(const Cluster &&c);
 
     /**
-     * @brief Check if the cluster already exists before inserting.
+     * @brief Insert a batch of clusters at once. The clusters get consecutive
+     * ids in the vector order and the memberships of their vertices are 
+     * indexed by a parallel count-then-fill (see Membership_index), which is
+     * much faster than inserting the clusters one by one.
+     * @param std::vector<Cluster> &&: clusters to be inserted (moved).
+    */
+    void insert(std::vector<Cluster> &&clusters);
+
+    /**
+     * @brief Check if the cluster already exists before inserting (see
+     * contains()).
      * @param const Cluster&: candidate cluster to be inserted.
      * @return bool: true if the cluster was inserted, false otherwise.
     */
@@ -161,6 +195,17 @@ public:
     */
     bool insert_v_in_clst(const unsigned int v, const unsigned int c_id);
 
+    /**
+     * @brief Insert batches of vertices in clusters: each pair is a cluster id
+     * and the vertices to be inserted in it. The clusters are merged with 
+     * their batches in parallel and the new memberships are indexed by a
+     * single parallel count-then-fill (see Membership_index).
+     * @param std::vector<std::pair<unsigned int, std::vector<unsigned int>>>
+     * &&: cluster ids and vertices batches (moved).
+    */
+    void insert_vs_in_clsts(
+        std::vector<std::pair<unsigned int, std::vector<unsigned int>>> &&batch);
+
     /**
      * @brief .
      * @param
@@ -181,8 +226,8 @@ public:
      * @param
      * @return
     */
-    std::unordered_set<unsigned int>::const_iterator remove_v_from_clst(
-        const std::unordered_set<unsigned int>::const_iterator itv,
+    std::vector<unsigned int>::const_iterator remove_v_from_clst(
+        const std::vector<unsigned int>::const_iterator itv,
         const unsigned int c_id);
 
     /**
@@ -213,6 +258,27 @@ public:
     */
     void write_clusters_in_file(const std::string &path) const;
 
+    /**
+    * @brief Write the clustering in a binary file that can be memory-mapped
+    * and queried without parsing. The integers are in the host byte order
+    * (little-endian on x86 and most ARM hosts) and every section starts at a
+    * multiple of 8 bytes:
+    *   header: char[8] magic "NISECLST", uint32 version (1), uint32 number of
+    *           vertices n, uint64 number of clusters k, uint64 number of
+    *           memberships m;
+    *   uint64 cluster_offsets[k + 1]: cluster i is members[cluster_offsets[i],
+    *           cluster_offsets[i + 1]);
+    *   uint32 members[m]: vertices of each cluster in increasing order;
+    *   uint64 vertex_offsets[n + 1]: vertex v belongs to the clusters
+    *           vertex_clusters[vertex_offsets[v], vertex_offsets[v + 1]);
+    *   uint32 vertex_clusters[m]: clusters of each vertex in increasing order.
+    * The section of members is padded with zeros to a multiple of 8 bytes.
+    * The clusters are numbered in the order of write_clusters_in_file, i.e.,
+    * cluster i is the ith line of the text file.
+    * @param const std::string&: ouput file path.
+    */
+    void write_clusters_in_binary_file(const std::string &path) const;
+
 private:
 
     /**
@@ -225,43 +291,55 @@ private:
      * belonging to, i.e., the ith position of m_v_clst keeps the indices of the
      * clusters that vertex i is contained into.
     */
-    std::vector<std::unordered_set<unsigned int>> m_v_clst;
+    Membership_index m_v_clst;
 
     /**
      * @brief Unordered map of ids and clusters.
     */
     std::unordered_map<unsigned int, Cluster> m_id_clst_map;
 
+    /**
+     * @brief Index of the clusters ids by their fingerprints. It is updated by
+     * every modification of the clusters.
+    */
+    std::unordered_multimap<std::uint64_t, unsigned int> m_fp_index;
+
+    /**
+     * @brief Flag to control if the overlap mapping is up to date. Whenever a
+     * cluster or a vertex membership changes, this flag is set to false.
+    */
+    mutable bool m_updated_ovlps = false;
+
     /**
      * @brief Mapping of the number of overlapping vertices that each pair of 
      * clusters share. The pair is the cluster id and the number of vertices
-     * that they share.
+     * that they share. It is a sparse matrix computed on demand (see 
+     * compute_ovlps()), so runs that never query overlaps do not pay for it.
     */
-    std::unordered_map<unsigned int, 
+    mutable std::unordered_map<unsigned int, 
         std::unordered_map<unsigned int, unsigned int>> m_id_ovlp_clsts_map;
 
     /**
-     * @brief .
-     * @param
-     * @param
-     * @return
+     * @brief Compute the overlap mapping (m_id_ovlp_clsts_map) if it is 
+     * outdated by one parallel pass over the clusters and the memberships of 
+     * their vertices (m_v_clst). The m_updated_ovlps flag is set to true.
     */
-    bool insert_ovlp_clst(const unsigned int c_id, const unsigned int o_id);
+    void compute_ovlps() const;
 
     /**
-     * @brief .
-     * @param
-     * @param
-     * @return
+     * @brief Update the fingerprint index entry of a modified cluster.
+     * @param const unsigned int: cluster id.
+     * @param const std::uint64_t: fingerprint before the modification.
     */
-    bool insert_v_belonging(const unsigned int v, const unsigned int c_id);
+    void reindex_fingerprint(const unsigned int c_id,
+        const std::uint64_t old_fp);
 
     /**
-     * @brief .
-     * @param
-     * @param
+     * @brief Remove the fingerprint index entry of a cluster.
+     * @param const unsigned int: cluster id.
+     * @param const std::uint64_t: fingerprint of the entry.
     */
-    void remove_ovlp_clst(const unsigned int c_id, const unsigned int oc_id);
+    void unindex_fingerprint(const unsigned int c_id, const std::uint64_t fp);
 
 };
 
@@ -0,0 +1,123 @@
+/*
+ * File: concurrent_queue.hpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Blocking multi-producer multi-consumer queue used to pipeline the
+ * NISE phases (e.g., the seeding phase produces seeds while the seed expansion
+ * threads consume them).
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 02:10 PM
+ */
+
+#ifndef CONCURRENT_QUEUE_HPP
+#define CONCURRENT_QUEUE_HPP
+
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+
+
+template <class T>
+class Concurrent_queue
+{
+public:
+
+    /**
+     * @brief Default constructor: creates an empty open queue.
+    */
+    Concurrent_queue() = default;
+
+    /**
+     * @brief Disabled copy constructor.
+    */
+    Concurrent_queue(const Concurrent_queue &other) = delete;
+
+    /**
+     * @brief Disabled assignment operator.
+    */
+    Concurrent_queue& operator=(const Concurrent_queue &other) = delete;
+
+    /**
+     * @brief Default destructor.
+    */
+    ~Concurrent_queue() = default;
+
+    /**
+     * @brief Close the queue: no element can be pushed after it and the
+     * consumers blocked in pop() are woken up once the queue is empty.
+    */
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_closed = true;
+        }
+        m_cv.notify_all();
+    }
+
+    /**
+     * @brief Remove the front element of the queue. If the queue is empty, it
+     * blocks until an element is pushed or the queue is closed.
+     * @param T &: output front element.
+     * @return bool: true if an element was popped, false if the queue is
+     * closed and empty.
+    */
+    bool pop(T &e)
+    {
+        std::unique_lock<std::mutex> locker(m_mutex);
+        m_cv.wait(locker, [this]()
+            {
+                return m_closed || !m_queue.empty();
+            });
+
+        if (m_queue.empty())
+        {
+            return false; // closed
+        }
+
+        e = std::move(m_queue.front());
+        m_queue.pop();
+        return true;
+    }
+
+    /**
+     * @brief Insert an element at the end of the queue and wake up one blocked
+     * consumer.
+     * @param const T &: element to be inserted.
+    */
+    void push(const T &e)
+    {
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_queue.push(e);
+        }
+        m_cv.notify_one();
+    }
+
+private:
+
+    /**
+     * @brief Flag of closed queue.
+    */
+    bool m_closed = false;
+
+    /**
+     * @brief Mutex that guards the queue and the closed flag.
+    */
+    std::mutex m_mutex;
+
+    /**
+     * @brief Condition variable used to wait for elements.
+    */
+    std::condition_variable m_cv;
+
+    /**
+     * @brief Queue itself.
+    */
+    std::queue<T> m_queue;
+};
+
+#endif /* CONCURRENT_QUEUE_HPP */
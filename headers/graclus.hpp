@@ -0,0 +1,65 @@
+/*
+ * File: graclus.hpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Header of the multilevel weighted kernel k-means clustering (Graclus)
+ * of Dhillon, Guan and Kulis [1]. It is used by the seeding by Graclus centers
+ * of the NISE algorithm [2].
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 10:12 AM
+ *
+ * References:
+ * [1] I. S. Dhillon, Y. Guan and B. Kulis. Weighted graph cuts without
+ * eigenvectors a multilevel approach, IEEE Transactions on Pattern Analysis and
+ * Machine Intelligence 29(11) (2007) p. 1944-1957.
+ * [2] J. J. Whang, D. F. Gleich and I. S. Dhillon. Overlapping community
+ * detection using neighborhood-inflated seed expansion, IEEE Transactions on
+ * Knowledge and Data Engineering 28(5) (2016) p. 1272-1284.
+ */
+
+#ifndef UTILS_GRACLUS_HPP
+#define UTILS_GRACLUS_HPP
+
+
+#include "./graph.hpp"
+
+
+namespace utils
+{
+namespace graclus
+{
+    /**
+    * @brief Multilevel normalized cut clustering (see [1]). The input graph is
+    * coarsened by heavy-edge matching until it is small enough, the coarsest
+    * graph is clustered by region growing and the clustering is refined by
+    * weighted kernel k-means at each level while it is projected back to the
+    * input graph. The matching, the coarse graph construction and the kernel
+    * k-means iterations are parallelized (OpenMP).
+    * @param const Graph &: input graph.
+    * @param const unsigned int: number of clusters k. If k is greater than the
+    * number of vertices, then each vertex is a cluster.
+    * @return std::vector<unsigned int>: cluster label, in [0, k), of each
+    * vertex. All k clusters are non-empty.
+    */
+    std::vector<unsigned int> partition(const Graph &g, const unsigned int k);
+
+    /**
+    * @brief Find the center of each cluster of the input partition, i.e., the
+    * vertex closest to the cluster centroid in the normalized cut kernel space
+    * (see [1,2]). Ties are broken by the largest degree and then by the
+    * smallest vertex index.
+    * @param const Graph &: input graph.
+    * @param const std::vector<unsigned int> &: cluster label of each vertex
+    * (as returned by partition).
+    * @return std::vector<unsigned int>: center vertex of each non-empty
+    * cluster.
+    */
+    std::vector<unsigned int> centers(const Graph &g,
+        const std::vector<unsigned int> &labels);
+
+} // graclus
+} // utils
+
+#endif /* UTILS_GRACLUS_HPP */
@@ -236,6 +236,13 @@ public:
     */
     unsigned int get_vtx_id(const std::string &l) const;
 
+    /**
+    * @brief Check if the vertices have labels, i.e., if the graph was created
+    * from a labeled input file.
+    * @return bool: true if there is at least a labeled vertex.
+    */
+    bool has_vtx_labels() const;
+
     /**
     * @brief TODO.
     * @param const unsigned int:.
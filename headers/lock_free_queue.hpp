@@ -0,0 +1,215 @@
+/*
+ * File: lock_free_queue.hpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Bounded lock-free multi-producer multi-consumer queue [1] used to feed
+ * the clusters writer thread from the seed expansion threads. Each cell of the
+ * ring buffer has a sequence number that tells whether it is ready to be
+ * written or read, so producers and consumers only synchronize through atomic
+ * operations on the cells and on the two cursors.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 10:05 PM
+ *
+ * References:
+ * [1] D. Vyukov. Bounded MPMC queue. 1024cores, 2010.
+ * https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ */
+
+#ifndef LOCK_FREE_QUEUE_HPP
+#define LOCK_FREE_QUEUE_HPP
+
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+
+template <class T>
+class Lock_free_queue
+{
+public:
+
+    /**
+     * @brief Disabled default constructor.
+    */
+    Lock_free_queue() = delete;
+
+    /**
+     * @brief Constructor: creates an empty open queue.
+     * @param const std::size_t: capacity (rounded up to a power of two).
+    */
+    explicit Lock_free_queue(const std::size_t capacity) :
+        m_mask(1),
+        m_enqueue_pos(0),
+        m_dequeue_pos(0)
+    {
+        while (m_mask < capacity)
+        {
+            m_mask <<= 1;
+        }
+        m_cells.reset(new cell[m_mask]);
+        for (std::size_t i = 0; i < m_mask; ++i)
+        {
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+        --m_mask;
+    }
+
+    /**
+     * @brief Disabled copy constructor.
+    */
+    Lock_free_queue(const Lock_free_queue &other) = delete;
+
+    /**
+     * @brief Disabled assignment operator.
+    */
+    Lock_free_queue& operator=(const Lock_free_queue &other) = delete;
+
+    /**
+     * @brief Default destructor.
+    */
+    ~Lock_free_queue() = default;
+
+    /**
+     * @brief Close the queue: no element can be pushed after it. It must be
+     * called once all producers are done.
+    */
+    void close()
+    {
+        m_closed.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Check if the queue is closed.
+     * @return bool: true if it is closed.
+    */
+    bool is_closed() const
+    {
+        return m_closed.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Insert an element at the end of the queue. If the queue is full,
+     * it yields until a consumer makes room (back pressure).
+     * @param T &&: element to be inserted (moved).
+    */
+    void push(T &&e)
+    {
+        while (!try_push(std::move(e)))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief Insert an element at the end of the queue if it is not full.
+     * @param T &&: element to be inserted (moved only on success).
+     * @return bool: true if the element was inserted, false if it is full.
+    */
+    bool try_push(T &&e)
+    {
+        cell *c;
+        std::size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            c = &m_cells[pos & m_mask];
+            const std::size_t seq = c->seq.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) -
+                static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) // the cell is free: try to take it
+            {
+                if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                    std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0) // the cell was not read yet: full
+            {
+                return false;
+            }
+            else // another producer took the cell
+            {
+                pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        c->data = std::move(e);
+        c->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the front element of the queue if it is not empty.
+     * @param T &: output front element.
+     * @return bool: true if an element was popped, false if it is empty.
+    */
+    bool try_pop(T &e)
+    {
+        cell *c;
+        std::size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            c = &m_cells[pos & m_mask];
+            const std::size_t seq = c->seq.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) -
+                static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) // the cell is written: try to take it
+            {
+                if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1,
+                    std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0) // the cell was not written yet: empty
+            {
+                return false;
+            }
+            else // another consumer took the cell
+            {
+                pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        e = std::move(c->data);
+        c->seq.store(pos + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+
+    /**
+     * @brief Ring buffer cell: element and sequence number.
+    */
+    struct cell
+    {
+        std::atomic<std::size_t> seq;
+        T data;
+    };
+
+    /**
+     * @brief Ring buffer (its size is m_mask + 1, a power of two).
+    */
+    std::unique_ptr<cell[]> m_cells;
+
+    /**
+     * @brief Mask of the ring buffer positions.
+    */
+    std::size_t m_mask;
+
+    /**
+     * @brief Cursors of the producers and of the consumers (in different cache
+     * lines to avoid false sharing).
+    */
+    alignas(64) std::atomic<std::size_t> m_enqueue_pos;
+    alignas(64) std::atomic<std::size_t> m_dequeue_pos;
+
+    /**
+     * @brief Flag of closed queue.
+    */
+    std::atomic<bool> m_closed{false};
+};
+
+#endif /* LOCK_FREE_QUEUE_HPP */
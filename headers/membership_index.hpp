@@ -0,0 +1,136 @@
+/*
+ * File: membership_index.hpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Vertex to clusters index used by the Clustering class. The clusters
+ * ids of each vertex are kept sorted in a row of a single flat array
+ * (compressed sparse row layout). Memberships are appended in bulk by a
+ * parallel count-then-fill, while single memberships are inserted in place when
+ * the row has room or by moving the row to the end of the array otherwise.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 07:10 PM
+ */
+
+#ifndef MEMBERSHIP_INDEX_HPP
+#define MEMBERSHIP_INDEX_HPP
+
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+class Membership_index
+{
+public:
+
+    /**
+     * @brief Disabled default constructor.
+    */
+    Membership_index() = delete;
+
+    /**
+     * @brief Constructor: creates an index with empty rows.
+     * @param const unsigned int: graph number of vertices.
+    */
+    explicit Membership_index(const unsigned int nb_vertices);
+
+    /**
+     * @brief Default destructor.
+    */
+    ~Membership_index() = default;
+
+    /**
+     * @brief Vertices range (begin and end const iterators).
+    */
+    typedef std::pair<std::vector<unsigned int>::const_iterator,
+        std::vector<unsigned int>::const_iterator> vertices_range;
+
+    /**
+     * @brief Append a batch of memberships: every vertex of the ith range
+     * joins the cluster c_ids[i]. The memberships must be new, i.e., no vertex
+     * belongs to its cluster yet. The rows are counted and then filled in
+     * parallel and the array is compacted along the way.
+     * @param const std::vector<unsigned int> &: clusters ids.
+     * @param const std::vector<vertices_range> &: vertices of each cluster.
+    */
+    void append(const std::vector<unsigned int> &c_ids,
+        const std::vector<vertices_range> &vertices);
+
+    /**
+     * @brief Remove the cluster c_id from the row of vertex v.
+     * @param const unsigned int: vertex.
+     * @param const unsigned int: cluster id.
+     * @return bool: true if it was removed, false if v does not belong to c_id.
+    */
+    bool erase(const unsigned int v, const unsigned int c_id);
+
+    /**
+     * @brief Insert the cluster c_id in the row of vertex v.
+     * @param const unsigned int: vertex.
+     * @param const unsigned int: cluster id.
+     * @return bool: true if it was inserted, false if v already belongs to
+     * c_id.
+    */
+    bool insert(const unsigned int v, const unsigned int c_id);
+
+    /**
+     * @brief Get the number of vertices (rows) of the index.
+     * @return unsigned int: number of vertices.
+    */
+    unsigned int nb_vertices() const;
+
+    /**
+     * @brief Get the clusters ids of vertex v in increasing order.
+     * @param const unsigned int: vertex.
+     * @return std::pair: begin and end const iterators of the row. They are
+     * invalidated by any modification of the index.
+    */
+    std::pair<
+        std::vector<unsigned int>::const_iterator,
+        std::vector<unsigned int>::const_iterator
+        >
+    row(const unsigned int v) const;
+
+    /**
+     * @brief Get the number of clusters that vertex v belongs to.
+     * @param const unsigned int: vertex.
+     * @return unsigned int: row size.
+    */
+    unsigned int row_size(const unsigned int v) const;
+
+private:
+
+    /**
+     * @brief Offset of each row in the flat array.
+    */
+    std::vector<std::size_t> m_offset;
+
+    /**
+     * @brief Size and capacity of each row.
+    */
+    std::vector<unsigned int> m_size;
+    std::vector<unsigned int> m_capacity;
+
+    /**
+     * @brief Flat array of clusters ids.
+    */
+    std::vector<unsigned int> m_ids;
+
+    /**
+     * @brief Number of unused positions left in the flat array by moved rows.
+    */
+    std::size_t m_holes;
+
+    /**
+     * @brief Rebuild the flat array with the rows contiguous in vertex order.
+     * Each row gets its size plus the extra capacity given by the parameter.
+     * @param const std::vector<unsigned int> &: extra capacity of each row
+     * (empty means no extra capacity).
+    */
+    void compact(const std::vector<unsigned int> &extra);
+};
+
+#endif /* MEMBERSHIP_INDEX_HPP */
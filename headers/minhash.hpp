@@ -0,0 +1,52 @@
+/*
+ * File: minhash.hpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Near-duplicate clusters detection by MinHash sketches and locality
+ * sensitive hashing (LSH) [1]. It is used to remove, after the seed expansion
+ * phase, clusters that are almost equal to other clusters, without comparing
+ * all pairs of clusters.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 09:05 PM
+ *
+ * References:
+ * [1] J. Leskovec, A. Rajaraman and J. D. Ullman. Mining of Massive Datasets,
+ * 2nd ed. Cambridge University Press, 2014. Chapter 3.
+ */
+
+#ifndef UTILS_MINHASH_HPP
+#define UTILS_MINHASH_HPP
+
+
+#include <vector>
+#include "./cluster.hpp"
+
+
+namespace utils
+{
+namespace minhash
+{
+    /**
+    * @brief Find the near-duplicate clusters (see [1]). Each cluster is
+    * sketched by MinHash and the sketches are split in bands; clusters that
+    * share a band bucket are candidate pairs, whose exact Jaccard similarity
+    * is then computed. Each cluster of a bucket is only paired with the
+    * largest one and with the previous one in decreasing size order, so a
+    * group of m (near-)identical clusters yields O(m) pairs instead of O(m^2). The clusters are visited in decreasing size order and
+    * a cluster is dropped if its similarity with an already kept cluster is at
+    * least the threshold. The sketching, the bucketing and the verification
+    * are parallelized (OpenMP).
+    * @param const std::vector<Cluster> &: clusters.
+    * @param const double: Jaccard similarity threshold in (0, 1].
+    * @return std::vector<bool>: flag of each cluster, true if it is a
+    * near-duplicate to be dropped.
+    */
+    std::vector<bool> near_duplicates(const std::vector<Cluster> &clusters,
+        const double threshold);
+
+} // minhash
+} // utils
+
+#endif /* UTILS_MINHASH_HPP */
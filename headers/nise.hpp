@@ -4,7 +4,8 @@
  *
  * @brief Header of the Whang, Gleich and Dhillon [1] algorithm: 
  * Neighborhood-Inflated Seed Expansion (NISE-SPH). This implementation uses the
- * Spread Hubs method for the seeding step.
+ * Spread Hubs method (default) or the Graclus centers method for the seeding
+ * step.
  *
  * (I'm sorry for my bad english xD)
  *
@@ -28,11 +29,22 @@
 #define NISE_ALGORITHM_HPP
 
 
+#include <atomic>
+#include <fstream>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include "../headers/clustering.hpp"
+#include "../headers/concurrent_queue.hpp"
+#include "../headers/lock_free_queue.hpp"
 #include "../headers/nise_parameters.hpp"
+#include "../headers/perf_counters.hpp"
+#include "../headers/ppr.hpp"
+#include "../headers/run_report.hpp"
+#include "../headers/time_mgmt.hpp"
+#include "../headers/trace.hpp"
 
 
 class Nise
@@ -72,8 +84,15 @@ public:
     Nise(const Graph &g, const Nise_parameters &params);
 
     /**
-     * @brief Constructor: .
-     * @param const Graph &:..
+     * @brief Constructor of the library use: a single configuration and the
+     * default values of the other parameters (see Nise_parameters). Nothing is
+     * written in files unless write_clustering() or write_report() is called,
+     * and nothing is printed. It throws std::invalid_argument if the 
+     * configuration is invalid (see Nise_parameters::is_valid()).
+     * @param const Graph &: graph (it must outlive this object).
+     * @param const unsigned int: number of seeds.
+     * @param const double: alpha.
+     * @param const double: epsilon.
     */
     Nise(const Graph &g, const unsigned int nb_seeds, const double alpha, 
         const double epsilon);
@@ -84,39 +103,189 @@ public:
     ~Nise() = default;
 
     /**
-    * @brief.
-    * @param:.
-    * @param:.
-    * @param:.
+    * @brief Run NISE [1] for the configurations of the parameters. The output
+    * of the filtering phase and the biconnected core graph are kept, so a new
+    * execution (e.g. by execute(nb_seeds, alpha, epsilon)) starts from the
+    * seeding phase. The clusterings of a previous execution are discarded.
+    * The OpenMP parallel loops of the calling thread use nb_threads() threads
+    * (flag "-n", the number of hardware threads by default) and the previous
+    * omp_set_num_threads() value of the calling thread is restored before
+    * returning.
     */
     void execute();
 
     /**
-    * @brief.
-    * @param:.
-    * @param:.
-    * @param:.
+    * @brief Run NISE [1] again for a single configuration, reusing the output
+    * of the filtering phase of the previous execution (if any). The other
+    * parameters are kept and the checkpoint is not read again. It throws
+    * std::invalid_argument if the configuration is invalid (see 
+    * Nise_parameters::is_valid()) and nothing is changed.
+    * @param const unsigned int: number of seeds.
+    * @param const double: alpha.
+    * @param const double: epsilon.
     */
     void execute(const unsigned int nb_seeds, const double alpha, 
         const double epsilon);
 
     /**
-    * @brief.
-    * @param:.
+    * @brief Run NISE [1] for a single configuration expanding the given seed
+    * vertices instead of the ones of the seeding phase. The seeds out of the
+    * biconnected core are skipped, since their whiskers are added to the
+    * clusters of the core by the propagation phase. The output of the
+    * filtering phase is reused as by execute(nb_seeds, alpha, epsilon),
+    * including the std::invalid_argument exception.
+    * @param const std::vector<unsigned int> &: seed vertices (the repeated
+    * ones are expanded once).
+    * @param const double: alpha.
+    * @param const double: epsilon.
+    */
+    void execute(const std::vector<unsigned int> &seeds, const double alpha,
+        const double epsilon);
+
+    /**
+    * @brief Run the filtering phase and build the biconnected core graph, if
+    * it was not done yet. execute() calls it, so it is only needed to warm up
+    * an object before its first execution (e.g. the server mode).
+    */
+    void prepare();
+
+    /**
+    * @brief Set the time limit of the seed expansion of the next executions.
+    * Once it is reached, the PPR pushes stop and the remaining seeds are not
+    * expanded, so the clusterings are incomplete (see timed_out()).
+    * @param const double: time limit in seconds (0 for no limit).
+    */
+    void set_time_limit(const double seconds);
+
+    /**
+    * @brief Check if the last execution reached the time limit.
+    * @return bool: true if its clusterings are incomplete.
+    */
+    bool timed_out() const;
+
+    /**
+    * @brief Get the clustering of each configuration found by the last
+    * execution, in the order of get_configurations(). The clusterings are
+    * empty in the streaming mode (flag "-l 1").
+    * @return const std::vector<Clustering> &: clusterings.
+    */
+    const std::vector<Clustering>& get_clusterings() const;
+
+    /**
+    * @brief Get the configurations of the last execution.
+    * @return const std::vector<Nise_parameters::configuration> &:
+    * configurations.
+    */
+    const std::vector<Nise_parameters::configuration>&
+        get_configurations() const;
+
+    /**
+    * @brief Write the clusterings in files: "./clustering.dat" for a single
+    * configuration or "./clustering_a<alpha>_e<epsilon>_s<seeds>.dat" for
+    * each configuration of a parameter sweep. Nothing is done in the
+    * streaming mode (flag "-l 1"), since the clusters were already written by
+    * execute().
     */
     void write_clustering() const;
 
+    /**
+    * @brief Write the run report (see Run_report) in the JSON file
+    * "<output path>.report.json": the wall time, CPU time and peak RSS of each
+    * phase and the run fields (graph, threads, configurations and number of
+    * clusters).
+    */
+    void write_report() const;
+
+    /**
+    * @brief Get the run report, e.g., to add the phases measured out of
+    * execute() such as the graph loading.
+    * @return Run_report &: run report.
+    */
+    Run_report& get_report();
+
+    /**
+    * @brief Get the number of seed expansions done by execute(), i.e., the
+    * number of (configuration, seed) pairs expanded.
+    * @return unsigned long long: number of expansions.
+    */
+    unsigned long long get_nb_expansions() const;
+
+    /**
+    * @brief Get the total number of pushes of the PPR vectors computed by
+    * execute() (see Ppr_vector).
+    * @return unsigned long long: number of pushes.
+    */
+    unsigned long long get_nb_pushes() const;
+
+    /**
+    * @brief Add a phase measured out of execute() (e.g. the graph loading) to
+    * the run report and to the trace.
+    * @param const std::string &: phase name.
+    * @param const utils::time_mgmt &: timer of the phase (already ended).
+    */
+    void report_phase(const std::string &name, const utils::time_mgmt &tmgmt);
+
+    /**
+    * @brief Write the trace of the run (flag "-t") in the Chrome trace event
+    * format: the phases, the seed expansions on their threads, the lock waits
+    * of the expanded clusters insertion and the I/O. Nothing is done if the
+    * tracing is off.
+    */
+    void write_trace() const;
+
 private:
 
+    /**
+    * @brief Seed found by the seeding phase. The rank is the number of seeds
+    * found before the batch (e.g. the spread hubs independent set) of this
+    * seed. A configuration with k seeds expands the seed if rank < k, which
+    * yields the same seeds of a standalone run with k seeds.
+    */
+    struct seed_entry
+    {
+        unsigned int vtx;
+        unsigned int rank;
+    };
+
+    /**
+    * @brief Cluster streamed to the writer thread (flag "-l 1"): the
+    * configuration index and the cluster formatted as a line of the clustering
+    * file.
+    */
+    struct streamed_clst
+    {
+        unsigned int config_id;
+        std::string line;
+    };
+
+    /**
+    * @brief Statistics of the expansion of a seed for a configuration (flag
+    * "-x"): the number of pushes of this expansion (only the extra pushes if
+    * the PPR vector was refined), the number of touched vertices and of
+    * vertices with positive PPR value (support), the size of the sweep set of
+    * minimum conductance (before the propagation phase), its conductance and
+    * the expansion wall time in seconds.
+    */
+    struct expansion_stats
+    {
+        unsigned long long nb_pushes;
+        std::size_t nb_touched;
+        std::size_t support_size;
+        std::size_t sweep_prefix;
+        double min_conductance;
+        double time;
+    };
+
     /**
     * @brief Graph const reference.
     */
     const Graph &m_graph;
 
     /**
-    * @brief .
+    * @brief Parameters of the run (the configuration is replaced by
+    * execute(nb_seeds, alpha, epsilon)).
     */
-    const Nise_parameters m_p;
+    Nise_parameters m_p;
 
     /**
     * @brief .
@@ -129,14 +298,138 @@ private:
     bool m_executed = false;
 
     /**
-    * @brief .
+    * @brief Time limit of the seed expansion in seconds (0 for no limit), the
+    * deadline of the current execution and the flag of a reached deadline.
+    */
+    double m_time_limit = 0;
+    std::chrono::steady_clock::time_point m_deadline =
+        std::chrono::steady_clock::time_point::max();
+    std::atomic<bool> m_timed_out{false};
+
+    /**
+    * @brief Wall time of execute() in seconds.
     */
     double m_execution_time = 0;
 
     /**
-    * @brief .
+    * @brief Run report (see write_report). It is mutable because the const
+    * writing methods also report their phases.
+    */
+    mutable Run_report m_report;
+
+    /**
+    * @brief Number of clusters streamed for each configuration (flag "-l 1").
+    */
+    std::vector<std::size_t> m_nb_streamed;
+
+    /**
+    * @brief Number of seed expansions and of PPR pushes of the run. Each
+    * expansion thread adds its own counts once it ends.
+    */
+    std::atomic<unsigned long long> m_nb_expansions{0};
+    std::atomic<unsigned long long> m_nb_pushes{0};
+
+    /**
+    * @brief Seeds statistics log file (flag "-x") and the mutex that guards
+    * it. The expansion threads append their buffers to it.
+    */
+    std::ofstream m_stats_file;
+    std::mutex m_stats_mutex;
+
+    /**
+    * @brief Performance counters of the phases (flag "-p 1"). They count the
+    * thread of execute() and the threads it creates. It is mutable because the
+    * const writing methods also report their phases.
+    */
+    mutable Perf_counters m_phase_counters;
+
+    /**
+    * @brief Performance counters of each seed expansion thread (flag "-p 1").
+    */
+    std::vector<Run_report::counters> m_thread_counters;
+
+    /**
+    * @brief Trace of the run (flag "-t"), or nullptr if the tracing is off.
+    */
+    std::unique_ptr<Trace> m_trace;
+
+    /**
+    * @brief Configurations of the run (more than one in the parameter-sweep
+    * mode). They share the graph, the filtering phase output and the seeds.
+    */
+    std::vector<Nise_parameters::configuration> m_configs;
+
+    /**
+    * @brief Configurations indices sorted by alpha and then by decreasing
+    * epsilon: with the warm start (flag "-r 1"), the expansion of a seed for a
+    * configuration starts from its PPR vector of the previous configuration
+    * with the same alpha.
     */
-    Clustering m_clusters;
+    std::vector<unsigned int> m_config_order;
+
+    /**
+    * @brief Number of seeds to be found: the largest number of seeds of all
+    * configurations.
+    */
+    unsigned int m_nb_seeds;
+
+    /**
+    * @brief Clustering of each configuration.
+    */
+    std::vector<Clustering> m_clusterings;
+
+    /**
+    * @brief Clusters expanded by the seed expansion threads for each 
+    * configuration. They are inserted in the clusterings in bulk once the seed
+    * expansion phase ends.
+    */
+    std::vector<std::vector<Cluster>> m_expanded_clsts;
+
+    /**
+    * @brief Fingerprints of the expanded clusters of each configuration and
+    * their positions in m_expanded_clsts. Only used to discard repeated
+    * clusters on the fly (flag "-d 1").
+    */
+    std::vector<std::unordered_multimap<std::uint64_t, std::size_t>>
+        m_expanded_fps;
+
+    /**
+    * @brief Seeds already expanded by a previous run (loaded from the
+    * checkpoint). They are skipped by the seed expansion phase.
+    */
+    std::unordered_set<unsigned int> m_done_seeds;
+
+    /**
+    * @brief Output of the filtering phase (biconnected core vertices, flag
+    * vector of the original graph and bridges) and the biconnected core graph.
+    * They are computed by the first execution and reused by the next ones.
+    */
+    std::vector<unsigned int> m_bcore_v;
+    std::vector<bool> m_contained_in_bcore;
+    std::vector<Graph::edge> m_bridges;
+    std::unique_ptr<Graph> m_bcore_g;
+
+    /**
+    * @brief Seeds given by execute(seeds, alpha, epsilon) as biconnected core
+    * vertices. The seeding phase pushes them instead of finding its own seeds
+    * if m_given_seeds is true.
+    */
+    std::vector<unsigned int> m_seeds;
+    bool m_given_seeds = false;
+
+    /**
+    * @brief Whisker mapping used in the streaming mode (flag "-l 1"): the
+    * vertices of the whiskers attached to each biconnected core vertex. The
+    * propagation phase is applied to each cluster by this mapping as soon as
+    * the cluster is expanded.
+    */
+    std::unordered_map<unsigned int, std::vector<unsigned int>> m_whisker_map;
+
+    /**
+    * @brief Queue of the clusters to be written by the writer thread. It is
+    * only created in the streaming mode (flag "-l 1").
+    */
+    std::unique_ptr<Lock_free_queue<streamed_clst>> m_stream_q;
 
     /**
     * @brief (see [1]).
@@ -147,68 +440,199 @@ private:
         std::vector<Graph::edge>> filtering_phase(Graph g);
 
     /**
-    * @brief (see [1]).
+    * @brief Filtering phase (or checkpoint loading) and biconnected core graph
+    * construction. Nothing is done if they are already available.
+    * @param utils::time_mgmt &: phase timer (see add_phase_to_report).
+    * @param std::vector<unsigned int> &: output seeds already expanded (loaded
+    * from the checkpoint).
+    */
+    void build_bcore(utils::time_mgmt &phase_tmgmt,
+        std::vector<unsigned int> &done_seeds);
+
+    /**
+    * @brief Initialize the clusterings, the expanded clusters and the
+    * configurations order for the configurations in m_configs.
+    */
+    void init_configurations();
+
+    /**
+    * @brief Clear the results and the counts of the previous execution.
+    */
+    void reset_run();
+
+    /**
+    * @brief End the timer (and the performance counters, if the profiling is
+    * on) of a phase, add the phase to the report and restart them for the next
+    * phase.
+    * @param const std::string &: phase name.
+    * @param utils::time_mgmt &: phase timer.
+    */
+    void add_phase_to_report(const std::string &name,
+        utils::time_mgmt &tmgmt) const;
+
+    /**
+    * @brief (see [1]). The whiskers are propagated to the clusterings of all
+    * configurations with a single search per bridge.
+    * @param .
     * @param .
+    * @param const unsigned int: only clusters with id greater or equal to it
+    * are updated (smaller ids were loaded from a checkpoint).
     */
     void propagation_phase(const std::vector<Graph::edge> &bridges, 
-        std::vector<bool> &contained_in_bcore);
+        std::vector<bool> &contained_in_bcore, const unsigned int first_clst_id);
+
+    /**
+    * @brief Find the whisker of each bridge (see [1]), i.e., the tree of
+    * vertices out of the biconnected core attached to the bridge. The
+    * whiskers of different bridges are disjoint, so they are searched in
+    * parallel.
+    * @param const std::vector<Graph::edge> &: bridges.
+    * @param const std::vector<bool> &: biconnected core flag vector.
+    * @return std::vector<std::pair<unsigned int, std::vector<unsigned int>>>:
+    * biconnected core vertex and whisker vertices of each bridge.
+    */
+    std::vector<std::pair<unsigned int, std::vector<unsigned int>>>
+        find_whiskers(const std::vector<Graph::edge> &bridges,
+        const std::vector<bool> &contained_in_bcore) const;
+
+    /**
+    * @brief Writer thread of the streaming mode (flag "-l 1"): pops the
+    * streamed clusters and writes them in the file of their configuration
+    * until the queue is closed and empty. The files are flushed whenever the
+    * queue is empty, so partial results are available during the run.
+    * @param std::vector<std::ofstream> &: output file of each configuration.
+    */
+    void clusters_writer_thread_task(std::vector<std::ofstream> &files);
+
+    /**
+    * @brief Remove the near-duplicate clusters expanded for each configuration
+    * (see utils::minhash::near_duplicates), i.e., the clusters whose Jaccard
+    * similarity with a larger kept cluster is at least the "-j" threshold.
+    */
+    void remove_near_duplicates();
+
+    /**
+    * @brief Load the checkpoint (if it exists) given by the parameters. The
+    * checkpoint clusters are inserted in the clustering and its seeds will not
+    * be expanded again. It aborts if the checkpoint does not match the graph
+    * or the parameters of this run.
+    * @param std::vector<bool> &: output biconnected core flag vector.
+    * @param std::vector<Graph::edge> &: output bridges.
+    * @param std::vector<unsigned int> &: output seeds already expanded.
+    * @return bool: true if the run was resumed from a checkpoint, false
+    * otherwise.
+    */
+    bool resume_from_checkpoint(std::vector<bool> &contained_in_bcore,
+        std::vector<Graph::edge> &bridges,
+        std::vector<unsigned int> &done_seeds);
 
     /**
     * @brief Seed expansion phase by personalized PageRank vectors (see [1,3]).
-    * @param const unsigned int: seed vertex in which the expansion starts.
-    * @param:.
-    * @param:.
+    * @param const Graph &: biconnected core graph.
+    * @param const std::vector<unsigned int> &: vertices indices of the original
+    * graph that belong to the biconnected core.
+    * @param Ppr_vector &: PPR vector of the seed vertex in which the expansion
+    * starts. It is refined in place, so a vector approximated with a larger
+    * epsilon is reused (warm start).
+    * @param const double: epsilon value.
+    * @param expansion_stats *: output statistics of the expansion, or nullptr
+    * if they are not recorded.
     * @return Cluster: Cluster with min conductance expanded from seed vertex.
     */
     Cluster seed_expansion_by_ppr(
         const Graph &bcore_g, 
         const std::vector<unsigned int> &bcore_v,
-        const unsigned int seed);
+        Ppr_vector &ppr,
+        const double epsilon,
+        expansion_stats *stats = nullptr);
 
     /**
-    * @brief .
-    * @param .
-    * @param .
-    * @param .
+    * @brief Seed expansion phase (see [1]). It is pipelined with the seeding
+    * phase: the expansion threads drain the seeds queue while the seeding
+    * phase is still pushing seeds into it. It returns when the queue is closed
+    * and all its seeds were expanded.
+    * @param const Graph &: biconnected core graph.
+    * @param const std::vector<unsigned int> &: vertices indices of the original
+    * graph that belong to the biconnected core.
+    * @param Concurrent_queue<unsigned int> &: seeds queue.
     */
     void seed_expansion_phase(const Graph &bcore_g, 
         const std::vector<unsigned int> &bcore_v,
-        const std::vector<unsigned int> &seeds);
+        Concurrent_queue<seed_entry> &seeds_q);
 
     /**
-    * @brief .
-    * @param .
-    * @param .
-    * @param .
+    * @brief Seed expansion thread: pops seeds from the queue and expands them
+    * for each configuration that uses them until the queue is closed and empty.
+    * So all (configuration, seed) expansions share the same threads.
+    * @param const Graph &: biconnected core graph.
+    * @param const std::vector<unsigned int> &: vertices indices of the original
+    * graph that belong to the biconnected core.
+    * @param Concurrent_queue<unsigned int> &: seeds queue.
+    * @param const unsigned int: thread index (used in the seeds statistics).
     */
     void seed_expansion_thread_task(const Graph &bcore_g, 
         const std::vector<unsigned int> &bcore_v,
-        const std::vector<unsigned int> &seeds, 
+        Concurrent_queue<seed_entry> &seeds_q,
         const unsigned int thread_id);
 
 
     /**
-    * @brief Seeding by spread hubs (see [1]).
-    * @param const unsigned int: the # of seeds which is the # of clusters.
+    * @brief Seeding by Graclus centers (see [1,2]): the biconnected core graph
+    * is clustered by the multilevel Graclus algorithm into k clusters and the
+    * center of each cluster is a seed. The seeds are pushed in the queue once
+    * the clustering is done.
+    * @param const Graph &: biconnected core graph.
+    * @param Concurrent_queue<unsigned int> &: seeds queue.
     * @return std::vector<unsigned int>: vector containing the seed vertices.
     */
-    std::vector<unsigned int> 
-        seeding_by_spread_hubs(const Graph &bcore_g) const;
+    std::vector<unsigned int> seeding_by_graclus_centers(const Graph &bcore_g,
+        Concurrent_queue<seed_entry> &seeds_q) const;
 
     /**
-    * @brief Seeding phase (see [1]).
-    * @param const Wgd_algorithm::seeding_method: enum of the chosen seeding 
-    * method (seeding by GRACLUS Centers or by Spread Hubs).
-    * @param const unsigned int: number of seeds to be found.
+    * @brief Seeding by spread hubs (see [1]). Each seed is pushed in the queue
+    * as soon as it is found, i.e., in decreasing degree order.
+    * @param const Graph &: biconnected core graph.
+    * @param Concurrent_queue<unsigned int> &: seeds queue.
     * @return std::vector<unsigned int>: vector containing the seed vertices.
     */
-    std::vector<unsigned int> seeding_phase(const Graph &bcore_g) const;
+    std::vector<unsigned int> seeding_by_spread_hubs(const Graph &bcore_g,
+        Concurrent_queue<seed_entry> &seeds_q) const;
+
+    /**
+    * @brief Seeding phase (see [1]). The seeding method (seeding by GRACLUS
+    * Centers or by Spread Hubs) is chosen by the Nise_parameters. The seeds
+    * queue is closed when the phase ends.
+    * @param const Graph &: biconnected core graph.
+    * @param Concurrent_queue<unsigned int> &: seeds queue.
+    * @return std::vector<unsigned int>: vector containing the seed vertices.
+    */
+    std::vector<unsigned int> seeding_phase(const Graph &bcore_g,
+        Concurrent_queue<seed_entry> &seeds_q) const;
+
+    /**
+     * @brief Store the cluster expanded for a configuration (see 
+     * m_expanded_clsts). If the deduplication is on, a cluster equal to one
+     * already expanded for the configuration is discarded. It is called by the
+     * seed expansion threads. In the streaming mode (flag "-l 1"), the
+     * whiskers of the cluster are added by the whisker mapping and the cluster
+     * is sent to the writer thread instead.
+     * @param Cluster &&: cluster to be stored (moved).
+     * @param const unsigned int: configuration index.
+     * @param Trace::Thread_buffer &: trace buffer of the calling thread (the
+     * lock waits are recorded in it).
+    */
+    void shared_clst_insertion(Cluster &&clst,
+        const unsigned int config_id, Trace::Thread_buffer &trace_buffer);
 
     /**
-     * @brief TODO.
-     * @param const Cluster&:.
+    * @brief Write the checkpoint of this run (see Nise_checkpoint).
+    * @param const std::vector<bool> &: biconnected core flag vector.
+    * @param const std::vector<Graph::edge> &: bridges.
+    * @param const std::vector<unsigned int> &: expanded seeds.
     */
-    void shared_clst_insertion(const Cluster &clst);
+    void write_checkpoint(const std::vector<bool> &contained_in_bcore,
+        const std::vector<Graph::edge> &bridges,
+        const std::vector<unsigned int> &seeds) const;
 };
 
 
@@ -20,17 +20,47 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <vector>
 
 
 class Nise_parameters
 {
 public:
 
+    /**
+     * @brief Seeding methods of NISE [1]: spread hubs (flag value "sph") or
+     * Graclus centers (flag value "graclus").
+     */
+    enum seeding_method {spread_hubs, graclus_centers};
+
+    /**
+     * @brief A NISE [1] configuration, i.e., the parameters that change the
+     * seed expansion of a run. Several configurations can be run at once in
+     * the parameter-sweep mode (flag "-w").
+     */
+    struct configuration
+    {
+        double alpha;
+        double epsilon;
+        unsigned int nb_seeds;
+    };
+
     /**
      * @brief Default constructor.
      */
     Nise_parameters() = default;
 
+    /**
+     * @brief Constructor of the library use (see Nise): a single configuration
+     * and the default values of the optional flags, which can be changed by
+     * set(). There is no graph file, since the graph is built by the caller.
+     * The progress messages are off (flag "-i 0").
+     * @param const configuration &: alpha, epsilon and number of seeds. It
+     * throws std::invalid_argument if they are out of range (see 
+     * set_configuration()).
+     */
+    explicit Nise_parameters(const configuration &config);
+
     /**
      * @brief Default destructor.
      */
@@ -48,12 +78,138 @@ public:
      */
     double epsilon() const;
 
+    /**
+     * @brief Check if the repeated clusters must be discarded (flag "-d 1").
+     * @return bool: true if the deduplication is on, false otherwise.
+     */
+    bool dedup() const;
+
+    /**
+     * @brief Get the Jaccard similarity threshold of the near-duplicate
+     * clusters removal (flag "-j").
+     * @return double: threshold, 0 if the removal is off.
+     */
+    double jaccard_threshold() const;
+
+    /**
+     * @brief Check if the PPR vector of a seed must be refined from the one of
+     * the previous configuration with the same alpha in the parameter-sweep
+     * mode (flag "-r 1") instead of being computed from scratch.
+     * @return bool: true if the warm start is on, false otherwise.
+     */
+    bool warm_start() const;
+
+    /**
+     * @brief Check if the alpha and epsilon values are valid, i.e., alpha in
+     * (0, 1) and epsilon in (0, 1], since the push method does not converge
+     * otherwise.
+     * @param const double: alpha.
+     * @param const double: epsilon.
+     * @return bool: true if both values are valid, false otherwise.
+     */
+    static bool is_valid(const double alpha, const double epsilon);
+
+    /**
+     * @brief Check if the progress messages and the warnings must be printed
+     * on the standard output (flag "-i 1", the default of the terminal use).
+     * The errors are always printed on the standard error.
+     * @return bool: true if the messages are on, false otherwise.
+     */
+    bool verbose() const;
+
+    /**
+     * @brief Check if the clusters must be streamed to the output file as soon
+     * as they are expanded (flag "-l 1").
+     * @return bool: true if the streaming mode is on, false otherwise.
+     */
+    bool streaming() const;
+
+    /**
+     * @brief Check if the performance counters of the phases and of the seed
+     * expansion threads must be added to the run report (flag "-p 1").
+     * @return bool: true if the profiling is on, false otherwise.
+     */
+    bool profiling() const;
+
     /**
      * @brief Get the NISE-SPH [1] parameter number of seeds.
      * @return unsigned int: number of seeds.
      */
     unsigned int nb_of_seeds() const;
 
+    /**
+     * @brief Get the number of threads of the seed expansion phase and of the
+     * parallel loops (flag "-n").
+     * @return unsigned int: number of threads (the number of hardware threads
+     * by default).
+     */
+    unsigned int nb_threads() const;
+
+    /**
+     * @brief Get the configurations of the run. Without the sweep flag "-w"
+     * there is one configuration given by the "-a", "-e" and "-s" flags.
+     * Otherwise, each line of the sweep file is a configuration "alpha epsilon
+     * [nb_seeds]" (the "-s" value is used when nb_seeds is omitted).
+     * @return std::vector<configuration>: configurations.
+     */
+    std::vector<configuration> get_configurations() const;
+
+    /**
+     * @brief Get the NISE [1] seeding method.
+     * @return seeding_method: spread hubs (default) or Graclus centers.
+     */
+    seeding_method get_seeding_method() const;
+
+    /**
+     * @brief Get the checkpoint file path (flag "-c"). If the file exists the
+     * run is resumed from it and, at the end, the file is (re)written.
+     * @return std::string: checkpoint file path or empty if not used.
+     */
+    std::string get_checkpoint_path() const;
+
+    /**
+     * @brief Get the output clustering file path (flag "-o"). In the
+     * parameter-sweep mode the configuration is appended to the file name.
+     * @return std::string: output file path ("./clustering.dat" by default).
+     */
+    std::string get_output_path() const;
+
+    /**
+     * @brief Get the binary output clustering file path (flag "-b"). The binary
+     * file is written besides the text one (see
+     * Clustering::write_clusters_in_binary_file).
+     * @return std::string: binary output file path or empty if not used.
+     */
+    std::string get_binary_output_path() const;
+
+    /**
+     * @brief Get the seeds statistics log file path (flag "-x"). The
+     * statistics of each seed expansion are written in it as CSV.
+     * @return std::string: log file path or empty if not used.
+     */
+    std::string get_stats_path() const;
+
+    /**
+     * @brief Get the trace file path (flag "-t"). The timeline of the run is
+     * written in it in the Chrome trace event format.
+     * @return std::string: trace file path or empty if not used.
+     */
+    std::string get_trace_path() const;
+
+    /**
+     * @brief Get the Unix socket path of the server mode (flag "-u"). The
+     * graph is loaded once and the jobs are received through the socket (see
+     * Nise_server).
+     * @return std::string: socket path or empty if not used.
+     */
+    std::string get_socket_path() const;
+
+    /**
+     * @brief Get the time limit of each job of the server mode (flag "-q").
+     * @return double: time limit in seconds (60 by default).
+     */
+    double job_time_limit() const;
+
     /**
      * @brief Get the input graph file path.
      * @return std::string: graph file path.
@@ -69,6 +225,33 @@ public:
      */
     bool set_parameters(const int argc, char** argv);
 
+    /**
+     * @brief Set an optional flag as in the terminal user input, e.g.,
+     * set("-n", "4") or set("-m", "graclus").
+     * @param const std::string &: flag.
+     * @param const std::string &: flag value.
+     * @return bool: true if the flag and its value are valid.
+     */
+    bool set(const std::string &flag, const std::string &val_str);
+
+    /**
+     * @brief Replace the configurations of the run by a single one (the sweep
+     * flag "-w" is dropped).
+     * @param const configuration &: alpha, epsilon and number of seeds.
+     * @return bool: true if the values are valid (see is_valid() and a 
+     * positive number of seeds), false otherwise (nothing is changed).
+     */
+    bool set_configuration(const configuration &config);
+
+    /**
+     * @brief Check the flags that can not be used together: "-c" or
+     * "-m graclus" with "-w", "-l 1" with "-c", "-b", "-d 1" or "-j", and "-u"
+     * with "-c", "-w" or "-l 1".
+     * @return bool: true if the flags are compatible, false otherwise (the
+     * conflict is reported on the standard error).
+     */
+    bool check_flags() const;
+
 private:
 
     /**
@@ -76,11 +259,63 @@ private:
      */
     unsigned int m_nb_of_seeds;
 
+    /**
+     * @brief Number of threads (flag "-n"), 0 means the number of hardware
+     * threads.
+     */
+    unsigned int m_nb_threads = 0;
+
     /**
      * @brief
      */
     std::string m_graph_path;
 
+    /**
+     * @brief Sweep configurations read from the file of flag "-w". A zero
+     * number of seeds means the "-s" value.
+     */
+    std::vector<configuration> m_sweep;
+
+    /**
+     * @brief Checkpoint file path (flag "-c").
+     */
+    std::string m_checkpoint_path;
+
+    /**
+     * @brief Output clustering file path (flag "-o").
+     */
+    std::string m_output_path = "./clustering.dat";
+
+    /**
+     * @brief Binary output clustering file path (flag "-b").
+     */
+    std::string m_binary_output_path;
+
+    /**
+     * @brief Seeds statistics log file path (flag "-x").
+     */
+    std::string m_stats_path;
+
+    /**
+     * @brief Trace file path (flag "-t").
+     */
+    std::string m_trace_path;
+
+    /**
+     * @brief Unix socket path of the server mode (flag "-u").
+     */
+    std::string m_socket_path;
+
+    /**
+     * @brief Time limit of each job of the server mode in seconds (flag "-q").
+     */
+    double m_job_time_limit = 60; // magic number
+
+    /**
+     * @brief Seeding method (flag "-m").
+     */
+    seeding_method m_seeding_method = seeding_method::spread_hubs;
+
     /**
      * @brief Mapping of flags to values.
      */
@@ -88,30 +323,58 @@ private:
     {
         // default values following [1]
         {"-a", 0.99},
-        {"-e", 1e-4}
+        {"-e", 1e-4},
+        {"-d", 0}, // no deduplication
+        {"-j", 0}, // no near-duplicates removal
+        {"-l", 0}, // no streaming
+        {"-p", 0}, // no profiling
+        {"-r", 0}, // no warm start
+        {"-i", 1} // progress messages
     };
 
     /**
      * @brief
      * @param
-     * @param
      * @return
      */
-    bool set(const std::string &flag, const std::string &val_str);
+    bool set_graph_path(const std::string &path);
 
     /**
      * @brief
      * @param
      * @return
      */
-    bool set_graph_path(const std::string &path);
+    bool set_nb_of_seeds(const std::string &val_str);
 
     /**
-     * @brief
-     * @param
-     * @return
+     * @brief Set the number of threads from its flag value (positive integer).
+     * @param const std::string &: flag value.
+     * @return bool: true if the value is a valid number of threads.
      */
-    bool set_nb_of_seeds(const std::string &val_str);
+    bool set_nb_threads(const std::string &val_str);
+
+    /**
+     * @brief Set the time limit of the server jobs from its flag value
+     * (positive number of seconds).
+     * @param const std::string &: flag value.
+     * @return bool: true if the value is a valid time limit.
+     */
+    bool set_job_time_limit(const std::string &val_str);
+
+    /**
+     * @brief Read the sweep configurations file. Each line has the alpha and
+     * epsilon values and, optionally, the number of seeds.
+     * @param const std::string &: sweep file path.
+     * @return bool: true if the file exists and all lines are valid.
+     */
+    bool set_sweep(const std::string &path);
+
+    /**
+     * @brief Set the seeding method from its flag value ("sph" or "graclus").
+     * @param const std::string &: flag value.
+     * @return bool: true if the value is a valid seeding method.
+     */
+    bool set_seeding_method(const std::string &val_str);
 };
 
 #endif /* NISE_PARAMETERS_HPP */
\ No newline at end of file
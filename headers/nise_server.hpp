@@ -0,0 +1,161 @@
+/*
+ * File: nise_server.hpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Server mode of NISE-SPH [1] (flag "-u"): the graph is loaded and the
+ * filtering phase is run once, then the jobs are received through a local Unix
+ * socket and their clusterings are sent back. So a warm job only pays the
+ * seeding and seed expansion phases (and the propagation of its clusters).
+ *
+ * Each connection carries a single job: a line with the flags "-s", "-a", "-e"
+ * (as in the terminal, the values of the server are used for the missing
+ * ones) and/or "-v v1,v2,..." (seed vertices to be expanded instead of the
+ * seeding phase ones). The empty line and the degenerate alpha (not in
+ * (0, 1)) and epsilon (not in (0, 1]) values are rejected. The line "stop"
+ * stops the server once the queued jobs are done. The response is a line
+ * "OK <number of clusters> <time in seconds>" followed by the clusters in the
+ * clustering file format, or a line "ERROR <message>" (e.g. if the job
+ * reached the time limit of flag "-q").
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 20, 2026, 02:40 AM
+ *
+ * References:
+ * [1] J. J. Whang, D. F. Gleich and I. S. Dhillon. Overlapping community
+ * detection using neighborhood-inflated seed expansion, IEEE Transactions on
+ * Knowledge and Data Engineering 28(5) (2016) p. 1272-1284.
+ */
+
+#ifndef NISE_SERVER_HPP
+#define NISE_SERVER_HPP
+
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include "../headers/concurrent_queue.hpp"
+#include "../headers/nise.hpp"
+
+
+class Nise_server
+{
+public:
+
+    /**
+     * @brief Disabled default constructor.
+    */
+    Nise_server() = delete;
+
+    /**
+     * @brief Disabled copy constructor.
+    */
+    Nise_server(const Nise_server &other) = delete;
+
+    /**
+     * @brief Disabled assignment operator.
+    */
+    Nise_server& operator=(const Nise_server &other) = delete;
+
+    /**
+     * @brief Constructor.
+     * @param const Graph &: graph (loaded once for all jobs).
+     * @param const Nise_parameters &: parameters of the server: the socket
+     * path (flag "-u"), the default configuration of the jobs and the other
+     * flags (e.g. the number of threads).
+    */
+    Nise_server(const Graph &g, const Nise_parameters &params);
+
+    /**
+     * @brief Default destructor.
+    */
+    ~Nise_server() = default;
+
+    /**
+     * @brief Run the filtering phase, listen on the socket and serve the jobs
+     * until a "stop" request. The connections are non-blocking and polled by
+     * the calling thread, so a silent client does not block the others; a
+     * request not received in 10 seconds is dropped. The jobs are run one at a
+     * time by a worker thread, so all jobs share the seed expansion threads of
+     * the same Nise object (flag "-n"), and each job is interrupted at the time
+     * limit (flag "-q").
+     * @return bool: true if the server was stopped by a request, false if the
+     * socket could not be opened or accepted connections.
+    */
+    bool run();
+
+private:
+
+    /**
+     * @brief Job received: socket of the connection and request line.
+    */
+    struct job
+    {
+        int fd;
+        std::string request;
+    };
+
+    /**
+     * @brief Connection whose request is being read: socket, request read so
+     * far and accept time (see the request timeout).
+    */
+    struct connection
+    {
+        int fd;
+        std::string request;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /**
+     * @brief Configuration of a job parsed from its request line.
+    */
+    struct job_config
+    {
+        unsigned int nb_seeds;
+        double alpha;
+        double epsilon;
+        std::vector<unsigned int> seeds;
+        bool given_seeds;
+    };
+
+    /**
+     * @brief Server parameters.
+    */
+    const Nise_parameters m_p;
+
+    /**
+     * @brief NISE object shared by all jobs (it keeps the output of the
+     * filtering phase).
+    */
+    Nise m_nise;
+
+    /**
+     * @brief Jobs waiting for the worker thread.
+    */
+    Concurrent_queue<job> m_jobs;
+
+    /**
+     * @brief Parse a request line. The flags missing in it take the server
+     * values.
+     * @param const std::string &: request line.
+     * @param job_config &: output job configuration.
+     * @return bool: true if the request is valid (not empty, alpha in (0, 1)
+     * and epsilon in (0, 1]), false otherwise.
+    */
+    bool parse_request(const std::string &request, job_config &config) const;
+
+    /**
+     * @brief Run a job and build its response.
+     * @param const std::string &: request line.
+     * @return std::string: response.
+    */
+    std::string process(const std::string &request);
+
+    /**
+     * @brief Worker thread: pops the jobs, runs them and sends their responses
+     * until the queue is closed and empty.
+    */
+    void worker_thread_task();
+};
+
+#endif /* NISE_SERVER_HPP */
@@ -0,0 +1,94 @@
+/*
+ * File: perf_counters.hpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Hardware performance counters (cycles, instructions, cache misses and
+ * branch misses) of a code section, read by the Linux perf_event_open system
+ * call. Only user space is counted, so it works with the default
+ * perf_event_paranoid setting. Events that are not supported by the machine
+ * (e.g. in virtual machines) are skipped.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 11:30 PM
+ */
+
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+class Perf_counters
+{
+public:
+
+    /**
+     * @brief Default constructor: no counter is opened.
+    */
+    Perf_counters() = default;
+
+    /**
+     * @brief Disabled copy constructor.
+    */
+    Perf_counters(const Perf_counters &other) = delete;
+
+    /**
+     * @brief Disabled assignment operator.
+    */
+    Perf_counters& operator=(const Perf_counters &other) = delete;
+
+    /**
+     * @brief Destructor: closes the counters.
+    */
+    ~Perf_counters();
+
+    /**
+     * @brief Open the counters of the calling thread.
+     * @param const bool: if true, the threads created afterwards by the
+     * calling thread are also counted (their counts are added when they
+     * exit). Nothing is done if the counters are already open.
+     * @return bool: true if at least one counter was opened.
+    */
+    bool open(const bool inherit);
+
+    /**
+     * @brief Reset and enable the counters.
+    */
+    void start();
+
+    /**
+     * @brief Disable the counters and read them. The values are scaled if the
+     * counters were multiplexed by the kernel.
+    */
+    void stop();
+
+    /**
+     * @brief Get the values read by the last stop().
+     * @return std::vector<std::pair<std::string, unsigned long long>>: name and
+     * value of each opened counter.
+    */
+    std::vector<std::pair<std::string, unsigned long long>> get_values() const;
+
+private:
+
+    /**
+     * @brief Name, file descriptor and last value of each opened counter and
+     * its raw value, time enabled and time running at start().
+    */
+    struct counter
+    {
+        std::string name;
+        int fd;
+        unsigned long long value;
+        std::uint64_t base[3];
+    };
+
+    std::vector<counter> m_counters;
+};
+
+#endif /* PERF_COUNTERS_HPP */
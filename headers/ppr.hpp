@@ -0,0 +1,147 @@
+/*
+ * File: ppr.hpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Header of the approximate personalized PageRank (PPR) vector computed
+ * by the push method of Andersen, Chung and Lang [2] from a
+ * neighborhood-inflated seed, as used by the NISE seed expansion [1].
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 05:20 PM
+ *
+ * References:
+ * [1] J. J. Whang, D. F. Gleich and I. S. Dhillon. Overlapping community
+ * detection using neighborhood-inflated seed expansion, IEEE Transactions on
+ * Knowledge and Data Engineering 28(5) (2016) p. 1272-1284.
+ * [2] R. Andersen, F. Chung and K. Lang. Local Graph Partitioning using
+ * PageRank Vectors. In: Proceedings of the 47th Annual IEEE Symposium on
+ * Foundations of Computer Science. Berkeley, CA, USA: IEEE, 2006.
+ */
+
+#ifndef PPR_HPP
+#define PPR_HPP
+
+
+#include <chrono>
+#include <cstddef>
+#include <unordered_map>
+#include "./graph.hpp"
+
+
+class Ppr_vector
+{
+public:
+
+    /**
+     * @brief Disabled default constructor.
+    */
+    Ppr_vector() = delete;
+
+    /**
+     * @brief Constructor: the approximation x is zero and the residual r is
+     * the uniform distribution over the seed and its neighbors (see [1]). No
+     * push is done until approximate() is called.
+     * @param const Graph &: graph (biconnected core graph in NISE).
+     * @param const unsigned int: seed vertex.
+     * @param const double: teleportation parameter alpha.
+    */
+    Ppr_vector(const Graph &g, const unsigned int seed, const double alpha);
+
+    /**
+     * @brief Default destructor.
+    */
+    ~Ppr_vector() = default;
+
+    /**
+     * @brief Push residual mass until r[v] <= deg(v) * epsilon for every
+     * vertex v (see [2]): a vertex is queued again whenever a push raises its
+     * residual above the threshold. The push method is valid for any
+     * (x, r) pair, so a vector already approximated with a larger epsilon is
+     * refined from its current state (warm start) and only the extra pushes
+     * are paid. Calling it with an epsilon not smaller than the current one
+     * does nothing.
+     * @param const double: epsilon (tolerance).
+     * @param const std::chrono::steady_clock::time_point: the pushes stop at
+     * this time, leaving the vector approximated with its previous epsilon
+     * (no limit by default).
+     * @return bool: true if the vector was approximated, false if the
+     * deadline was reached.
+    */
+    bool approximate(const double epsilon,
+        const std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::time_point::max());
+
+    /**
+     * @brief Get the alpha value of this vector.
+     * @return double: alpha.
+    */
+    double get_alpha() const;
+
+    /**
+     * @brief Get the epsilon of the last approximation (infinity if it was
+     * not approximated yet).
+     * @return double: epsilon.
+    */
+    double get_epsilon() const;
+
+    /**
+     * @brief Get the number of pushes done by all approximate() calls.
+     * @return unsigned long long: number of pushes.
+    */
+    unsigned long long get_nb_pushes() const;
+
+    /**
+     * @brief Get the number of touched vertices, i.e., the vertices that have
+     * received residual mass.
+     * @return std::size_t: number of touched vertices.
+    */
+    std::size_t get_nb_touched() const;
+
+    /**
+     * @brief Get the seed vertex.
+     * @return unsigned int: seed.
+    */
+    unsigned int get_seed() const;
+
+    /**
+     * @brief Get the approximate PPR vector (only touched vertices).
+     * @return const std::unordered_map<unsigned int, double> &: x.
+    */
+    const std::unordered_map<unsigned int, double>& get_x() const;
+
+private:
+
+    /**
+     * @brief Graph const reference.
+    */
+    const Graph &m_graph;
+
+    /**
+     * @brief Seed vertex.
+    */
+    unsigned int m_seed;
+
+    /**
+     * @brief Teleportation parameter.
+    */
+    double m_alpha;
+
+    /**
+     * @brief Tolerance of the current approximation.
+    */
+    double m_epsilon;
+
+    /**
+     * @brief Number of pushes done so far.
+    */
+    unsigned long long m_nb_pushes;
+
+    /**
+     * @brief Approximation vector x and residual vector r (see [2]).
+    */
+    std::unordered_map<unsigned int, double> m_x;
+    std::unordered_map<unsigned int, double> m_r;
+};
+
+#endif /* PPR_HPP */
@@ -0,0 +1,119 @@
+/*
+ * File: run_report.hpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Machine-readable report of a NISE run. It keeps the wall time, the CPU
+ * time and the peak RSS of each phase (see utils::time_mgmt) and some fields
+ * of the run (graph, threads, configurations) and writes them in a JSON file,
+ * so the runs can be compared to track regressions.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 11:00 PM
+ */
+
+#ifndef RUN_REPORT_HPP
+#define RUN_REPORT_HPP
+
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "./time_mgmt.hpp"
+
+
+class Run_report
+{
+public:
+
+    /**
+     * @brief Default constructor: creates an empty report.
+    */
+    Run_report() = default;
+
+    /**
+     * @brief Default destructor.
+    */
+    ~Run_report() = default;
+
+    /**
+     * @brief Counters (name and value) of a phase, e.g., hardware performance
+     * counters (see Perf_counters).
+    */
+    typedef std::vector<std::pair<std::string, unsigned long long>> counters;
+
+    /**
+     * @brief Add a phase measured by a timer. The phases are reported in the
+     * order they were added.
+     * @param const std::string &: phase name.
+     * @param const utils::time_mgmt &: timer of the phase (already ended).
+     * @param const counters &: counters of the phase (none by default).
+    */
+    void add_phase(const std::string &name, const utils::time_mgmt &t,
+        const counters &phase_counters = counters());
+
+    /**
+     * @brief Set a field of the report. A field that already exists is
+     * replaced.
+     * @param const std::string &: field name.
+     * @param const std::string &: field value as a JSON value (see quote()).
+    */
+    void set_field(const std::string &name, const std::string &json_value);
+
+    /**
+     * @brief Get the wall time of a phase. If the phase was added more than
+     * once (e.g. in a parameter sweep), the times are summed.
+     * @param const std::string &: phase name.
+     * @return double: wall time in seconds, 0 if there is no such phase.
+    */
+    double get_wall_time(const std::string &name) const;
+
+    /**
+     * @brief Get a string as a JSON string (quoted and escaped).
+     * @param const std::string &: string.
+     * @return std::string: JSON string.
+    */
+    static std::string quote(const std::string &str);
+
+    /**
+     * @brief Get counters as a JSON object.
+     * @param const counters &: counters.
+     * @return std::string: JSON object.
+    */
+    static std::string to_json(const counters &c);
+
+    /**
+     * @brief Write the report in a JSON file: the fields and an array of the
+     * phases ("name", "wall_time_sec", "cpu_time_sec", "peak_rss_kb" and, if
+     * any, "counters").
+     * @param const std::string &: output file path.
+     * @return bool: true if the file was written, false otherwise.
+    */
+    bool write(const std::string &path) const;
+
+private:
+
+    /**
+     * @brief Measures of a phase.
+    */
+    struct phase
+    {
+        std::string name;
+        double wall_time;
+        double cpu_time;
+        long peak_rss;
+        counters phase_counters;
+    };
+
+    /**
+     * @brief Fields (name and JSON value) in the insertion order.
+    */
+    std::vector<std::pair<std::string, std::string>> m_fields;
+
+    /**
+     * @brief Phases in the insertion order.
+    */
+    std::vector<phase> m_phases;
+};
+
+#endif /* RUN_REPORT_HPP */
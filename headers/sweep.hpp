@@ -0,0 +1,84 @@
+/*
+ * File: sweep.hpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Sweep step of the seed expansion [1,2]: the vertices of an
+ * approximate personalized PageRank vector are sorted by probability-per-degree
+ * and the prefix (sweep set) of minimum conductance is the expanded cluster.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 20, 2026, 03:10 AM
+ *
+ * References:
+ * [1] J. J. Whang, D. F. Gleich and I. S. Dhillon. Overlapping community
+ * detection using neighborhood-inflated seed expansion, IEEE Transactions on
+ * Knowledge and Data Engineering 28(5) (2016) p. 1272-1284.
+ * [2] R. Andersen, F. Chung and K. Lang. Local Graph Partitioning using
+ * PageRank Vectors. In: Proceedings of the 47th Annual IEEE Symposium on
+ * Foundations of Computer Science. Berkeley, CA, USA: IEEE, 2006.
+ */
+
+#ifndef UTILS_SWEEP_HPP
+#define UTILS_SWEEP_HPP
+
+
+#include <unordered_map>
+#include <vector>
+#include "./cluster.hpp"
+#include "./graph.hpp"
+
+
+namespace utils
+{
+namespace sweep
+{
+    /**
+    * @brief Conductance of a set of vertices: its boundary edges over the
+    * minimum of its volume and of the volume of its complement.
+    * @param const unsigned int: graph number of edges.
+    * @param const unsigned int: volume of the set.
+    * @param const unsigned int: number of boundary edges of the set.
+    * @return double: conductance (1 for an empty set or for the whole graph).
+    */
+    double conductance(const unsigned int g_nb_edges, const unsigned int vol,
+        const unsigned int boundary_edges);
+
+    /**
+    * @brief Sort vertices indices in decreasing probability-per-degree (PPD)
+    * order. See [1,2] for details.
+    * @param const std::unordered_map<unsigned int, double> &: PPR vector
+    * (vertex and value).
+    * @param const Graph &: biconnected core graph.
+    * @return std::vector<unsigned int>: vertices of the PPR vector sorted in
+    * decreasing PPD order.
+    */
+    std::vector<unsigned int> sort_vertices_in_decreasing_ppd(
+        const std::unordered_map<unsigned int, double> &x,
+        const Graph &bcore_g);
+
+    /**
+    * @brief Given a set of vertices sorted in the deacreasing
+    * probability-per-degree order this method selects a set of vertices of
+    * minimum conductance (see [1,2]). This method is also known as
+    * degree-normalized version of the sweep technique [2].
+    * @param const Graph&: original graph.
+    * @param const Graph&: biconnected core graph.
+    * @param const std::vector<unsigned int>&: vertices indices of the original
+    * graph that belong to the biconnected core.
+    * @param const std::vector<unsigned int>&: graph vertices indices sorted by
+    * probability-per-degree order.
+    * @param double &: output minimum conductance.
+    * @return Cluster: set (cluster) of vertices with the minimum conductance
+    * value. As described in [2] this cluster is formed by the first p vertices
+    * in the "vertices_sppd" that, together, compose a cluster with minimum
+    * conductance. In other words, the sweep set with minimum conductance.
+    */
+    Cluster clst_min_conductance(const Graph &original_g, const Graph &bcore_g,
+        const std::vector<unsigned int> &bcore_v,
+        const std::vector<unsigned int> &vertices_sppd, double &min_cond);
+
+} // sweep
+} // utils
+
+#endif /* UTILS_SWEEP_HPP */
@@ -0,0 +1,101 @@
+/*
+ * File: time_mgmt.hpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Timer of a code section: it measures the wall time, the CPU time of
+ * the process (all threads) and the peak resident set size (RSS) of the
+ * process at the end of the section.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 10:40 PM
+ */
+
+#ifndef UTILS_TIME_MGMT_HPP
+#define UTILS_TIME_MGMT_HPP
+
+
+#include <chrono>
+
+
+namespace utils
+{
+
+class time_mgmt
+{
+public:
+
+    /**
+     * @brief Default constructor.
+    */
+    time_mgmt() = default;
+
+    /**
+     * @brief Default destructor.
+    */
+    ~time_mgmt() = default;
+
+    /**
+     * @brief Start (or restart) the timer.
+    */
+    void start();
+
+    /**
+     * @brief Stop the timer.
+    */
+    void end();
+
+    /**
+     * @brief Get the CPU time (user and system) of the process between start()
+     * and end(). The time of all threads of the process is accounted.
+     * @return double: CPU time in seconds.
+    */
+    double get_cpu_time_in_sec() const;
+
+    /**
+     * @brief Get the wall clock at end().
+     * @return std::chrono::steady_clock::time_point: end time.
+    */
+    std::chrono::steady_clock::time_point get_end_time() const;
+
+    /**
+     * @brief Get the peak resident set size of the process at end().
+     * @return long: peak RSS in kilobytes.
+    */
+    long get_peak_rss_in_kb() const;
+
+    /**
+     * @brief Get the wall clock at start().
+     * @return std::chrono::steady_clock::time_point: start time.
+    */
+    std::chrono::steady_clock::time_point get_start_time() const;
+
+    /**
+     * @brief Get the wall time between start() and end().
+     * @return double: wall time in seconds.
+    */
+    double get_total_time_in_sec() const;
+
+private:
+
+    /**
+     * @brief Wall clock at start() and end().
+    */
+    std::chrono::steady_clock::time_point m_start;
+    std::chrono::steady_clock::time_point m_end;
+
+    /**
+     * @brief Process CPU time (in seconds) at start() and end().
+    */
+    double m_cpu_start = 0;
+    double m_cpu_end = 0;
+
+    /**
+     * @brief Peak RSS (in kilobytes) at end().
+    */
+    long m_peak_rss = 0;
+};
+
+} // utils
+
+#endif /* UTILS_TIME_MGMT_HPP */
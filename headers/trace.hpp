@@ -0,0 +1,178 @@
+/*
+ * File: trace.hpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Timeline of a NISE run in the Chrome trace event format [1], which is
+ * read by chrome://tracing and by Perfetto. Each event is a span (complete
+ * event) of a thread: the phases, the seed expansions, the lock waits and the
+ * I/O. The threads record their events in their own buffers (see
+ * Trace::Thread_buffer), which are merged into the trace only when they are
+ * flushed, so the recording does not contend on a lock.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 20, 2026, 12:10 AM
+ *
+ * References:
+ * [1] Trace Event Format. https://docs.google.com/document/d/
+ * 1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+ */
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+class Trace
+{
+public:
+
+    typedef std::chrono::steady_clock clock;
+
+    /**
+     * @brief Span of a thread: name, category, begin and end times, thread
+     * index and arguments (members of a JSON object, e.g. "\"seed\": 3", or
+     * empty).
+    */
+    struct event
+    {
+        std::string name;
+        std::string cat;
+        clock::time_point start;
+        clock::time_point end;
+        unsigned int tid;
+        std::string args;
+    };
+
+    /**
+     * @brief Buffer of the events of a thread. The events are moved to the
+     * trace by flush() or by the destructor. A buffer of a null trace does
+     * nothing, so the recording code does not need to check if the tracing
+     * is on.
+    */
+    class Thread_buffer
+    {
+    public:
+
+        /**
+         * @brief Constructor: names the thread in the trace.
+         * @param Trace *: trace (nullptr if the tracing is off).
+         * @param const unsigned int: thread index.
+         * @param const std::string &: thread name.
+        */
+        Thread_buffer(Trace *trace, const unsigned int tid,
+            const std::string &name);
+
+        /**
+         * @brief Disabled copy constructor.
+        */
+        Thread_buffer(const Thread_buffer &other) = delete;
+
+        /**
+         * @brief Disabled assignment operator.
+        */
+        Thread_buffer& operator=(const Thread_buffer &other) = delete;
+
+        /**
+         * @brief Destructor: flushes the buffer.
+        */
+        ~Thread_buffer();
+
+        /**
+         * @brief Add a span of this thread.
+         * @param const std::string &: name.
+         * @param const std::string &: category.
+         * @param const clock::time_point: begin time.
+         * @param const clock::time_point: end time.
+         * @param const std::string &: arguments (see event).
+        */
+        void add(const std::string &name, const std::string &cat,
+            const clock::time_point start, const clock::time_point end,
+            const std::string &args = "");
+
+        /**
+         * @brief Check if the tracing is on.
+         * @return bool: true if the buffer has a trace.
+        */
+        bool enabled() const;
+
+        /**
+         * @brief Move the buffered events to the trace.
+        */
+        void flush();
+
+    private:
+
+        Trace *m_trace;
+        unsigned int m_tid;
+        std::vector<event> m_events;
+    };
+
+    /**
+     * @brief Default constructor: creates an empty trace.
+    */
+    Trace() = default;
+
+    /**
+     * @brief Default destructor.
+    */
+    ~Trace() = default;
+
+    /**
+     * @brief Add events to the trace. It is thread-safe.
+     * @param std::vector<event> &&: events (moved).
+    */
+    void add(std::vector<event> &&events);
+
+    /**
+     * @brief Add a span to the trace. It is thread-safe.
+     * @param const std::string &: name.
+     * @param const std::string &: category.
+     * @param const clock::time_point: begin time.
+     * @param const clock::time_point: end time.
+     * @param const unsigned int: thread index.
+    */
+    void add(const std::string &name, const std::string &cat,
+        const clock::time_point start, const clock::time_point end,
+        const unsigned int tid);
+
+    /**
+     * @brief Name a thread of the trace. It is thread-safe.
+     * @param const unsigned int: thread index.
+     * @param const std::string &: thread name.
+    */
+    void set_thread_name(const unsigned int tid, const std::string &name);
+
+    /**
+     * @brief Write the trace in a JSON file (Chrome trace event format). The
+     * times are in microseconds since the first event.
+     * @param const std::string &: output file path.
+     * @return bool: true if the file was written, false otherwise.
+    */
+    bool write(const std::string &path) const;
+
+private:
+
+    /**
+     * @brief Mutex that guards the events and the threads names.
+    */
+    mutable std::mutex m_mutex;
+
+    /**
+     * @brief Events of all threads.
+    */
+    std::vector<event> m_events;
+
+    /**
+     * @brief Name of each thread index.
+    */
+    std::map<unsigned int, std::string> m_thread_names;
+};
+
+#endif /* TRACE_HPP */
@@ -0,0 +1,183 @@
+/*
+ * File: checkpoint.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Implementation of the NISE checkpoint file. The file is binary and
+ * it is composed by a magic string followed by the sections in the order
+ * they are declared in the Nise_checkpoint struct. Vectors are prefixed by
+ * their sizes.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 03:52 PM
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "../headers/checkpoint.hpp"
+
+
+/////////////////////////////// Helper functions ///////////////////////////////
+
+namespace
+{
+
+/**
+ * @brief File format identification (the last char is the format version).
+*/
+const char magic[8] = {'N', 'I', 'S', 'E', 'C', 'K', 'P', '1'};
+
+template <class T>
+void write_pod(std::ofstream &f, const T &val)
+{
+    f.write(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+template <class T>
+bool read_pod(std::ifstream &f, T &val)
+{
+    return static_cast<bool>(f.read(reinterpret_cast<char*>(&val), sizeof(T)));
+}
+
+template <class T>
+void write_vector(std::ofstream &f, const std::vector<T> &vec)
+{
+    write_pod(f, static_cast<std::uint64_t>(vec.size()));
+    f.write(reinterpret_cast<const char*>(vec.data()), vec.size() * sizeof(T));
+}
+
+template <class T>
+bool read_vector(std::ifstream &f, std::vector<T> &vec)
+{
+    std::uint64_t size;
+    if (!read_pod(f, size))
+    {
+        return false;
+    }
+    vec.resize(size);
+    return static_cast<bool>(f.read(reinterpret_cast<char*>(vec.data()),
+        size * sizeof(T)));
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+bool Nise_checkpoint::read(const std::string &path)
+{
+    std::ifstream f(path, std::ios::binary);
+    if (!f)
+    {
+        return false;
+    }
+
+    char file_magic[sizeof(magic)];
+    if (!f.read(file_magic, sizeof(magic)) ||
+        std::memcmp(file_magic, magic, sizeof(magic)) != 0)
+    {
+        std::cerr << "[ERROR] Nise_checkpoint::read: " << path << " is not a "
+            "NISE checkpoint.\n";
+        return false;
+    }
+
+    bool ok = read_pod(f, nb_vertices) && read_pod(f, nb_edges) &&
+        read_pod(f, alpha) && read_pod(f, epsilon) &&
+        read_pod(f, seeding_method);
+
+    // biconnected core flags are packed in bytes
+    std::vector<std::uint8_t> packed;
+    ok = ok && read_vector(f, packed) && packed.size() == (nb_vertices + 7) / 8;
+    if (ok)
+    {
+        contained_in_bcore.assign(nb_vertices, false);
+        for (unsigned int v = 0; v < nb_vertices; ++v)
+        {
+            contained_in_bcore[v] = packed[v / 8] & (1u << (v % 8));
+        }
+    }
+
+    std::vector<unsigned int> bridges_endpoints;
+    ok = ok && read_vector(f, bridges_endpoints) &&
+        bridges_endpoints.size() % 2 == 0;
+    if (ok)
+    {
+        bridges.clear();
+        bridges.reserve(bridges_endpoints.size() / 2);
+        for (std::size_t i = 0; i < bridges_endpoints.size(); i += 2)
+        {
+            bridges.push_back(std::make_pair(bridges_endpoints[i],
+                bridges_endpoints[i + 1]));
+        }
+    }
+
+    ok = ok && read_vector(f, seeds);
+
+    std::uint64_t nb_clusters = 0;
+    ok = ok && read_pod(f, nb_clusters);
+    clusters.clear();
+    for (std::uint64_t i = 0; ok && i < nb_clusters; ++i)
+    {
+        clusters.emplace_back();
+        ok = read_vector(f, clusters.back());
+    }
+
+    if (!ok)
+    {
+        std::cerr << "[ERROR] Nise_checkpoint::read: truncated checkpoint "
+            << path << ".\n";
+    }
+
+    return ok;
+}
+
+
+void Nise_checkpoint::write(const std::string &path) const
+{
+    const std::string tmp_path = path + ".tmp";
+    std::ofstream f(tmp_path, std::ios::binary | std::fstream::trunc);
+
+    f.write(magic, sizeof(magic));
+    write_pod(f, nb_vertices);
+    write_pod(f, nb_edges);
+    write_pod(f, alpha);
+    write_pod(f, epsilon);
+    write_pod(f, seeding_method);
+
+    std::vector<std::uint8_t> packed((nb_vertices + 7) / 8, 0);
+    for (unsigned int v = 0; v < nb_vertices; ++v)
+    {
+        if (contained_in_bcore[v])
+        {
+            packed[v / 8] |= (1u << (v % 8));
+        }
+    }
+    write_vector(f, packed);
+
+    std::vector<unsigned int> bridges_endpoints;
+    bridges_endpoints.reserve(2 * bridges.size());
+    for (const auto &e : bridges)
+    {
+        bridges_endpoints.push_back(e.first);
+        bridges_endpoints.push_back(e.second);
+    }
+    write_vector(f, bridges_endpoints);
+
+    write_vector(f, seeds);
+
+    write_pod(f, static_cast<std::uint64_t>(clusters.size()));
+    for (const auto &c : clusters)
+    {
+        write_vector(f, c);
+    }
+
+    f.close();
+    if (!f || std::rename(tmp_path.c_str(), path.c_str()) != 0)
+    {
+        std::cerr << "[ERROR] Nise_checkpoint::write: it was not possible to "
+            "write the checkpoint " << path << ".\n";
+    }
+}
@@ -16,12 +16,139 @@
 
 
 #include <algorithm>
-#include <cmath>
-#include <functional>
+#include <iterator>
+#include <limits>
 #include <iostream>
 #include "../headers/cluster.hpp"
 
 
+/////////////////////////////// Helper functions ///////////////////////////////
+
+namespace
+{
+
+/**
+ * @brief Hash of a vertex index (splitmix64 finalizer). The fingerprint of a
+ * cluster is the sum of the hashes of its vertices.
+ * @param const unsigned int: vertex index.
+ * @return std::uint64_t: hash value.
+*/
+std::uint64_t vertex_hash(const unsigned int v)
+{
+    std::uint64_t h = static_cast<std::uint64_t>(v) + 0x9e3779b97f4a7c15ULL;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+}
+
+/**
+ * @brief Key of the free slots of the counters tables (see find_slot()). It is
+ * not a valid vertex index.
+*/
+const unsigned int free_slot = std::numeric_limits<unsigned int>::max();
+
+/**
+ * @brief Minimum number of slots of a counters table.
+*/
+const std::size_t min_table_size = 16; // magic number
+
+/**
+ * @brief Find the slot of the vertex u in an open addressing (linear probing)
+ * table of (vertex, counter) pairs whose size is a power of two and that has
+ * at least one free slot.
+ * @param const std::vector<std::pair<unsigned int, unsigned int>> &: table.
+ * @param const unsigned int: vertex.
+ * @return std::size_t: slot of u, or the free slot where it must be put.
+*/
+std::size_t find_slot(
+    const std::vector<std::pair<unsigned int, unsigned int>> &table,
+    const unsigned int u)
+{
+    const std::size_t mask = table.size() - 1;
+    std::size_t i = vertex_hash(u) & mask;
+    while (table[i].first != u && table[i].first != free_slot)
+    {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+/**
+ * @brief Add k to the counter of the vertex u (it is created if needed). The
+ * table is doubled when it would be more than half full.
+ * @param std::vector<std::pair<unsigned int, unsigned int>> &: table.
+ * @param unsigned int &: number of counters in the table.
+ * @param const unsigned int: vertex.
+ * @param const unsigned int: increment.
+*/
+void add_count(std::vector<std::pair<unsigned int, unsigned int>> &table,
+    unsigned int &nb_counts, const unsigned int u, const unsigned int k)
+{
+    if (2 * (static_cast<std::size_t>(nb_counts) + 1) > table.size())
+    {
+        std::vector<std::pair<unsigned int, unsigned int>> old(
+            std::max(min_table_size, 2 * table.size()),
+            std::make_pair(free_slot, 0u));
+        old.swap(table);
+        for (const auto &u_count : old)
+        {
+            if (u_count.first != free_slot)
+            {
+                table[find_slot(table, u_count.first)] = u_count;
+            }
+        }
+    }
+
+    auto &u_count = table[find_slot(table, u)];
+    if (u_count.first == free_slot)
+    {
+        u_count = std::make_pair(u, k);
+        ++nb_counts;
+    }
+    else
+    {
+        u_count.second += k;
+    }
+}
+
+/**
+ * @brief Decrement the counter of the vertex u, which must be in the table,
+ * and remove it when it reaches zero. The following pairs of its probing
+ * sequence are shifted back, so no tombstone is left.
+ * @param std::vector<std::pair<unsigned int, unsigned int>> &: table.
+ * @param unsigned int &: number of counters in the table.
+ * @param const unsigned int: vertex.
+*/
+void sub_count(std::vector<std::pair<unsigned int, unsigned int>> &table,
+    unsigned int &nb_counts, const unsigned int u)
+{
+    std::size_t i = find_slot(table, u);
+    assert(table[i].first == u);
+    if (--table[i].second > 0)
+    {
+        return;
+    }
+
+    const std::size_t mask = table.size() - 1;
+    for (std::size_t j = (i + 1) & mask; table[j].first != free_slot;
+        j = (j + 1) & mask)
+    {
+        // the pair in j stays if its home slot is cyclically in (i, j]
+        const std::size_t home = vertex_hash(table[j].first) & mask;
+        if (i <= j ? (i < home && home <= j) : (i < home || home <= j))
+        {
+            continue;
+        }
+        table[i] = table[j];
+        i = j;
+    }
+    table[i] = std::make_pair(free_slot, 0u);
+    --nb_counts;
+}
+
+} // anonymous namespace
+
+
 ///////////////////////// non-member friend functions //////////////////////////
 
 
@@ -29,8 +156,7 @@ std::ostream& operator<<(std::ostream& out, const Cluster &clst)
 {
     out << "{";
     std::string sep = "";
-    for (auto v : clst.m_vertices_set)
-    // for (auto v : clst.m_vertices_vector)
+    for (auto v : clst.m_vertices)
     {
         out << sep << v;
         sep = ", ";
@@ -42,20 +168,7 @@ std::ostream& operator<<(std::ostream& out, const Cluster &clst)
 
 bool operator==(const Cluster &lhs, const Cluster &rhs)
 {
-    if (lhs.m_vertices_set.size() != rhs.m_vertices_set.size())
-    {
-        return false;
-    }
-
-    for (auto v : lhs.m_vertices_set)
-    {
-        if (!rhs.contains(v))
-        {
-            return false;
-        }
-    }
-
-    return true;
+    return lhs.m_vertices == rhs.m_vertices; // both are sorted
 }
 
 
@@ -68,10 +181,11 @@ bool operator!=(const Cluster &lhs, const Cluster &rhs)
 Cluster operator+(const Cluster &lhs, const Cluster &rhs)
 {
     assert(&lhs.m_graph == &rhs.m_graph); // must be clusters of same graph
-    Cluster c(lhs.m_graph);
-    c += lhs;
-    c += rhs;
-    return c;
+    std::vector<unsigned int> vertices;
+    vertices.reserve(lhs.size() + rhs.size());
+    std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+        std::back_inserter(vertices));
+    return Cluster(lhs.m_graph, std::move(vertices));
 }
 
 
@@ -86,98 +200,118 @@ Cluster::Cluster(const Graph &g) :
 {}
 
 
-Cluster& Cluster::operator=(const std::initializer_list<unsigned int> &vertices)
+Cluster::Cluster(const Graph &g, std::vector<unsigned int> vertices) :
+    m_graph(g),
+    m_updated_degrees(false),
+    m_internal_degree(0),
+    m_external_degree(0),
+    m_vertices(std::move(vertices))
 {
-    std::for_each(std::begin(vertices), std::end(vertices), 
-        std::bind(std::mem_fun(&Cluster::insert), this, std::placeholders::_1));
-    return *this;
+    std::sort(m_vertices.begin(), m_vertices.end());
+    m_vertices.erase(std::unique(m_vertices.begin(), m_vertices.end()),
+        m_vertices.end());
+    m_vertices.shrink_to_fit();
+    assert(m_vertices.empty() || m_vertices.back() < g.get_nb_vertices());
+    compute_fingerprint();
+    update_bitmap();
 }
 
 
-Cluster& Cluster::operator+=(const Cluster &rhs)
-{
-    assert(&this->m_graph == &rhs.m_graph); // must be clusters of same graph
-    std::for_each(std::begin(rhs), std::end(rhs), 
-        std::bind(std::mem_fn(&Cluster::insert), this, std::placeholders::_1));
-    return *this;
-}
+Cluster::Cluster(const Cluster &other) :
+    m_graph(other.m_graph),
+    m_updated_degrees(false),
+    m_internal_degree(0),
+    m_external_degree(0),
+    m_fingerprint(other.m_fingerprint),
+    m_vertices(other.m_vertices),
+    m_bitmap(other.m_bitmap)
+{}
 
 
-std::unordered_set<unsigned int>::iterator Cluster::begin()
+Cluster& Cluster::operator=(const std::initializer_list<unsigned int> &vertices)
 {
-    return m_vertices_set.begin();
+    insert(std::vector<unsigned int>(vertices));
+    return *this;
 }
 
 
-// std::vector<unsigned int>::iterator Cluster::begin()
-// {
-//     return m_vertices_vector.begin();
-// }
-
-
-std::unordered_set<unsigned int>::const_iterator Cluster::begin() const
+Cluster& Cluster::operator+=(const Cluster &rhs)
 {
-    return m_vertices_set.cbegin();
+    assert(&this->m_graph == &rhs.m_graph); // must be clusters of same graph
+    insert(std::vector<unsigned int>(rhs.begin(), rhs.end()));
+    return *this;
 }
 
 
-// std::vector<unsigned int>::const_iterator Cluster::begin() const
-// {
-//     return m_vertices_vector.cbegin();
-// }
-
-
-std::unordered_set<unsigned int>::iterator Cluster::end()
+std::vector<unsigned int>::const_iterator Cluster::begin() const
 {
-    return m_vertices_set.end();
+    return m_vertices.cbegin();
 }
 
 
-std::unordered_set<unsigned int>::const_iterator Cluster::end() const
+std::vector<unsigned int>::const_iterator Cluster::end() const
 {
-    return m_vertices_set.cend();
+    return m_vertices.cend();
 }
 
 
-
 bool Cluster::contains(const unsigned int v) const
 {
     assert(v < m_graph.get_nb_vertices());
-    return m_vertices_set.find(v) != m_vertices_set.end();
+    if (!m_bitmap.empty())
+    {
+        return m_bitmap[v];
+    }
+    return std::binary_search(m_vertices.begin(), m_vertices.end(), v);
 }
 
 
 bool Cluster::empty() const
 {
-    return m_vertices_set.empty();
+    return m_vertices.empty();
 }
 
 
-std::pair<
-    std::unordered_set<unsigned int>::const_iterator, 
-    std::unordered_set<unsigned int>::const_iterator
-    > 
-    Cluster::get_external_adj_vertices() const
+std::vector<unsigned int> Cluster::get_external_adj_vertices() const
 {
-    return std::make_pair(m_ext_adj_vertices.cbegin(), 
-        m_ext_adj_vertices.cend());
+    compute_degrees();
+    std::vector<unsigned int> ext_adj_vertices;
+    ext_adj_vertices.reserve(m_nb_ext_adj);
+    for (const auto &v_count : m_ext_adj_count)
+    {
+        if (v_count.first != free_slot)
+        {
+            ext_adj_vertices.push_back(v_count.first);
+        }
+    }
+    std::sort(ext_adj_vertices.begin(), ext_adj_vertices.end());
+    return ext_adj_vertices;
 }
 
 
 unsigned int Cluster::get_external_degree() const
 {
+    compute_degrees();
     return m_external_degree;
 }
 
 
 unsigned int Cluster::get_internal_degree() const
 {
+    compute_degrees();
     return m_internal_degree;
 }
 
 
+std::uint64_t Cluster::get_fingerprint() const
+{
+    return m_fingerprint;
+}
+
+
 unsigned int Cluster::get_volume() const
 {
+    compute_degrees();
     return m_internal_degree + m_external_degree;
 }
 
@@ -186,20 +320,91 @@ bool Cluster::insert(const unsigned int v)
 {
     assert(v < m_graph.get_nb_vertices());
 
-    if (m_vertices_set.insert(v).second)
+    auto it = std::lower_bound(m_vertices.begin(), m_vertices.end(), v);
+    if (it != m_vertices.end() && *it == v)
     {
-        update_degrees(v, vertex_operation::insertion);
-        return true;
+        return false;
     }
-    
-    return false;
+
+    m_vertices.insert(it, v);
+    m_fingerprint += vertex_hash(v);
+    if (!m_bitmap.empty())
+    {
+        m_bitmap[v] = true;
+    }
+    else
+    {
+        update_bitmap();
+    }
+    update_degrees(v, vertex_operation::insertion);
+    return true;
+}
+
+
+unsigned int Cluster::insert(std::vector<unsigned int> vertices)
+{
+    std::sort(vertices.begin(), vertices.end());
+    vertices.erase(std::unique(vertices.begin(), vertices.end()),
+        vertices.end());
+    std::vector<unsigned int> merged;
+    merged.reserve(size() + vertices.size());
+    std::set_union(m_vertices.begin(), m_vertices.end(), vertices.begin(),
+        vertices.end(), std::back_inserter(merged));
+
+    const unsigned int nb_inserted = merged.size() - size();
+    if (nb_inserted > 0)
+    {
+        assert(merged.back() < m_graph.get_nb_vertices());
+        m_vertices = std::move(merged);
+        compute_fingerprint();
+        release_degrees();
+        if (!m_bitmap.empty())
+        {
+            for (auto v : vertices)
+            {
+                m_bitmap[v] = true;
+            }
+        }
+        update_bitmap();
+    }
+    return nb_inserted;
 }
 
 
 bool Cluster::is_an_external_adj_vtx(const unsigned int v) const
 {
     assert(v < m_graph.get_nb_vertices());
-    return m_ext_adj_vertices.find(v) != m_ext_adj_vertices.end();
+
+    if (contains(v))
+    {
+        return false;
+    }
+
+    if (m_updated_degrees)
+    {
+        return m_nb_ext_adj > 0 &&
+            m_ext_adj_count[find_slot(m_ext_adj_count, v)].first == v;
+    }
+
+    auto adj_list = m_graph.adj_list_of_vtx(v);
+    for (auto it = adj_list.first; it != adj_list.second; ++it)
+    {
+        if (contains(*it))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void Cluster::release_degrees()
+{
+    m_updated_degrees = false;
+    m_nb_ext_adj = 0;
+    m_ext_adj_count.clear();
+    m_ext_adj_count.shrink_to_fit();
 }
 
 
@@ -207,44 +412,57 @@ bool Cluster::remove(const unsigned int v)
 {
     assert(v < m_graph.get_nb_vertices());
 
-    if (contains(v))
+    auto it = std::lower_bound(m_vertices.cbegin(), m_vertices.cend(), v);
+    if (it == m_vertices.cend() || *it != v)
     {
-        m_vertices_set.erase(v);
-        update_degrees(v, vertex_operation::removal);
-        return true;
+        return false;
     }
-    
-    return false;
+
+    remove(it);
+    return true;
 }
 
 
-std::unordered_set<unsigned int>::const_iterator
-    Cluster::remove(const std::unordered_set<unsigned int>::const_iterator it)
+std::vector<unsigned int>::const_iterator
+    Cluster::remove(const std::vector<unsigned int>::const_iterator it)
 {
-    if (contains(*it))
+    if (it == m_vertices.cend())
     {
-        auto itr = m_vertices_set.erase(it);
-        update_degrees(*it, vertex_operation::removal);
-        return itr;
+        return m_vertices.cend();
     }
 
-    return m_vertices_set.end();
+    update_degrees(*it, vertex_operation::removal); // v is still contained
+    if (!m_bitmap.empty())
+    {
+        m_bitmap[*it] = false;
+    }
+    m_fingerprint -= vertex_hash(*it);
+    auto pos = it - m_vertices.cbegin();
+    m_vertices.erase(it);
+    update_bitmap();
+    return m_vertices.cbegin() + pos;
 }
 
 
 unsigned int Cluster::size() const
 {
-    return m_vertices_set.size();
+    return m_vertices.size();
 }
 
 
-void Cluster::compute_degrees()
+void Cluster::compute_degrees() const
 {
+    if (m_updated_degrees)
+    {
+        return;
+    }
+
     m_internal_degree = 0;
     m_external_degree = 0;
+    m_nb_ext_adj = 0;
+    m_ext_adj_count.clear();
 
-    for (auto v : m_vertices_set)
-    // for (auto v : m_vertices_vector)
+    for (auto v : m_vertices)
     {
         auto adj_list = m_graph.adj_list_of_vtx(v);
 
@@ -257,6 +475,7 @@ void Cluster::compute_degrees()
             else
             {
                 ++m_external_degree;
+                add_count(m_ext_adj_count, m_nb_ext_adj, *it, 1);
             }
         }
     }
@@ -265,87 +484,85 @@ void Cluster::compute_degrees()
 }
 
 
-void Cluster::update_adjacency(const unsigned int v, const vertex_operation op)
+void Cluster::update_degrees(const unsigned int v, const vertex_operation op)
 {
-    switch (op)
+    if (!m_updated_degrees)
     {
-        default:
-        {
-            std::cerr << "Cluster::update_adjacency: invalid vtx operation!\n";
-            exit(EXIT_FAILURE);
-        }
-        case vertex_operation::insertion :
-        {
-            m_ext_adj_vertices.insert(v);
-            break;
-        }
-        case vertex_operation::removal :
-        {
-            if (m_ext_adj_vertices.find(v) != m_ext_adj_vertices.end())
-            {
-                m_ext_adj_vertices.erase(v);
-            }
-            break;
-        }
+        return; // nothing to maintain: degrees were never asked for
     }
-}
 
-
-void Cluster::update_degrees(const unsigned int v, const vertex_operation op)
-{
-    unsigned int e = static_cast<unsigned int>(op); // insetion = 0, removal = 1
     auto adj_list = m_graph.adj_list_of_vtx(v);
-    bool vtx_has_internal_adj = false;
-    for (auto it_v = adj_list.first; it_v != adj_list.second; ++it_v)
+    if (op == vertex_operation::insertion) // v is already contained
     {
-        const unsigned int u = *it_v;
-        if (contains(u))
-        {
-            m_external_degree += 1 * std::pow(-1, e + 1);
-            // each internal edge is considered twice
-            m_internal_degree += 2 * std::pow(-1, e);
-            vtx_has_internal_adj = true;
-        }
-        else
+        for (auto it = adj_list.first; it != adj_list.second; ++it)
         {
-            m_external_degree += 1 * std::pow(-1, e);
-            if (op == vertex_operation::removal)
+            if (contains(*it))
             {
-                /* for v removal, it is necessary to check whether u has another
-                adjacency inside the cluster. If it has, then u won't be removed
-                from 'm_ext_adj_vertices' container. If it has not, then u will
-                be removed from 'm_ext_adj_vertices' container. */
-                bool has_another_adj = false;
-                auto adj_l_u = m_graph.adj_list_of_vtx(u);
-                for (auto it_u = adj_l_u.first; it_u != adj_l_u.second; ++it_u)
-                {
-                    if (contains(*it_u))
-                    {
-                        has_another_adj = true;
-                        break;
-                    }
-                }
-                if (!has_another_adj)
+                // edge (v, u) was external from u side and now it is internal
+                // (each internal edge is considered twice)
+                --m_external_degree;
+                m_internal_degree += 2;
+                if (*it != v) // v was counted once per cluster neighbor
                 {
-                    update_adjacency(u, op);
+                    sub_count(m_ext_adj_count, m_nb_ext_adj, v);
                 }
             }
             else
             {
-                /* for insertion no need to check u adjacency because the
-                'm_ext_adj_vertices' container won't keep repeated vertices */
-                update_adjacency(u, op);
+                ++m_external_degree;
+                add_count(m_ext_adj_count, m_nb_ext_adj, *it, 1);
+            }
+        }
+    }
+    else // removal: v is still contained
+    {
+        unsigned int nb_internal_adj = 0;
+        for (auto it = adj_list.first; it != adj_list.second; ++it)
+        {
+            if (contains(*it))
+            {
+                ++m_external_degree;
+                m_internal_degree -= 2;
+                ++nb_internal_adj;
+            }
+            else
+            {
+                --m_external_degree;
+                sub_count(m_ext_adj_count, m_nb_ext_adj, *it);
             }
         }
+        if (nb_internal_adj > 0)
+        {
+            add_count(m_ext_adj_count, m_nb_ext_adj, v, nb_internal_adj);
+        }
+    }
+}
+
+
+void Cluster::compute_fingerprint()
+{
+    m_fingerprint = 0;
+    for (auto v : m_vertices)
+    {
+        m_fingerprint += vertex_hash(v);
     }
+}
+
 
-    /* if v has at least one adjacency with a vertex inside cluster, then it is
-    necessary to update the 'm_ext_adj_vertices' container. If v was removed
-    from cluster, then it will be inserted in 'm_ext_adj_vertices'. If v was
-    inserted in cluster, then it will removed from 'm_ext_adj_vertices'. */
-    if (vtx_has_internal_adj)
+void Cluster::update_bitmap()
+{
+    const unsigned int threshold = m_graph.get_nb_vertices() / bitmap_ratio;
+    if (m_bitmap.empty() && m_vertices.size() >= std::max(threshold, 1u))
     {
-        update_adjacency(v, (op == vertex_operation::removal ? // invert
-            vertex_operation::insertion : vertex_operation::removal));
+        m_bitmap.assign(m_graph.get_nb_vertices(), false);
+        for (auto v : m_vertices)
+        {
+            m_bitmap[v] = true;
+        }
     }
-}
\ No newline at end of file
+    else if (!m_bitmap.empty() && m_vertices.size() < threshold / 2)
+    {
+        m_bitmap.clear();
+        m_bitmap.shrink_to_fit();
+    }
+}
@@ -14,43 +14,225 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "../headers/clustering.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
-#include <sstream>
+#include <iterator>
+#include <omp.h>
+
+
+/////////////////////////////// Helper functions ///////////////////////////////
+
+namespace
+{
+
+/**
+ * @brief The clusters are written in blocks of about this number of
+ * memberships. Each block is split in parts_per_thread parts per thread.
+*/
+const std::size_t write_block_size = 1 << 23; // magic number
+const long long parts_per_thread = 4; // magic number
+
+/**
+ * @brief Format clusters in the clustering file format (one cluster per line
+ * and vertices separated by a space) and append them to a buffer.
+ * @param const std::vector<const Cluster*> &: clusters.
+ * @param const std::size_t: first cluster position.
+ * @param const std::size_t: past-the-last cluster position.
+ * @param std::string &: output buffer.
+*/
+void format_clusters(const std::vector<const Cluster*> &clusters,
+    const std::size_t first, const std::size_t last, std::string &buffer)
+{
+    std::size_t nb_vertices = 0;
+    for (std::size_t i = first; i < last; ++i)
+    {
+        nb_vertices += clusters[i]->size();
+    }
+    // at most 10 digits and a separator per vertex and a newline per cluster
+    buffer.resize(11 * nb_vertices + (last - first));
+
+    char *out = &buffer[0];
+    char *const end = out + buffer.size();
+    for (std::size_t i = first; i < last; ++i)
+    {
+        bool first_v = true;
+        for (auto v : *clusters[i])
+        {
+            if (!first_v)
+            {
+                *out++ = ' ';
+            }
+            out = std::to_chars(out, end, v).ptr;
+            first_v = false;
+        }
+        *out++ = '\n';
+    }
+    buffer.resize(out - &buffer[0]);
+}
+
+/**
+ * @brief Version of the binary clustering file format.
+*/
+const std::uint32_t binary_format_version = 1;
+
+/**
+ * @brief Write an array of integers in a binary file. The integers are written
+ * as they are in memory, so the file is little-endian on little-endian hosts.
+ * @param std::ofstream &: output file.
+ * @param const T *: array.
+ * @param const std::size_t: array size.
+*/
+template <typename T>
+void write_binary(std::ofstream &f, const T *data, const std::size_t size)
+{
+    f.write(reinterpret_cast<const char*>(data), size * sizeof(T));
+}
+
+/**
+ * @brief Minimum size (in bytes) of a chunk of the clustering file parsed by a
+ * thread.
+*/
+const std::size_t min_chunk_size = 1 << 16; // magic number
+
+/**
+ * @brief Parse the lines of a clustering file chunk (see
+ * Clustering::write_clusters_in_file) into clusters. Each line is a cluster
+ * (an empty line is an empty cluster) and its tokens are the vertices labels
+ * or, if the graph has no labels, the vertices ids.
+ * @param const Graph &: graph.
+ * @param const char *: chunk begin (a line begin).
+ * @param const char *: chunk end (a line end).
+ * @param std::vector<Cluster> &: output clusters in the lines order.
+ * @return bool: true if all tokens are valid vertices, false otherwise.
+*/
+bool parse_clusters(const Graph &g, const char *first, const char *last,
+    std::vector<Cluster> &clusters)
+{
+    const bool labeled = g.has_vtx_labels();
+    std::string label;
+    std::vector<unsigned int> vertices;
+    while (first != last)
+    {
+        const char *eol = std::find(first, last, '\n');
+        vertices.clear();
+        while (first != eol)
+        {
+            if (std::isspace(static_cast<unsigned char>(*first)))
+            {
+                ++first;
+                continue;
+            }
+            const char *token_end = std::find_if(first, eol, [](const char c)
+                {
+                    return std::isspace(static_cast<unsigned char>(c));
+                });
+            unsigned int v = Graph::invalid_vertex_id();
+            if (labeled)
+            {
+                label.assign(first, token_end);
+                v = g.get_vtx_id(label);
+            }
+            // if the graph vertices has no labels then the token is the id
+            if (v == Graph::invalid_vertex_id() &&
+                (std::from_chars(first, token_end, v).ptr != token_end ||
+                v >= g.get_nb_vertices()))
+            {
+                return false;
+            }
+            vertices.push_back(v);
+            first = token_end;
+        }
+        clusters.emplace_back(g, vertices);
+        first = eol == last ? last : eol + 1;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 
 
 Clustering::Clustering(const unsigned int nb_vertices) :
     m_id_upper_bound(0),
-    m_v_clst(nb_vertices, std::unordered_set<unsigned int>())
+    m_v_clst(nb_vertices)
 {}
 
 
+Clustering::Clustering(const unsigned int nb_vertices,
+    std::vector<Cluster> &&clusters) :
+    m_id_upper_bound(0),
+    m_v_clst(nb_vertices)
+{
+    insert(std::move(clusters));
+}
+
+
 Clustering::Clustering(const Graph &g, const std::string &path) :
     m_id_upper_bound(0),
-    m_v_clst(g.get_nb_vertices(), std::unordered_set<unsigned int>())
-{
-    std::ifstream f(path);
-    std::istringstream content(std::string((std::istreambuf_iterator<char>(f)),
-        (std::istreambuf_iterator<char>())));
-    std::string line;
-    while (std::getline(content, line))
-    {
-        unsigned int c_id = insert(Cluster(g));
-        std::stringstream ss(line);
-        std::string l; // vertex label
-        while (ss >> l)
-        {
-            // return invalid id if graph vertices has no label
-            unsigned int v_id = g.get_vtx_id(l);
-            // if the graph vertices has no labels then convert l to integer
-            if (v_id == Graph::invalid_vertex_id())
-            {
-                v_id = static_cast<unsigned int>(std::stoi(l));
-            }
-            insert_v_in_clst(v_id, c_id);
-        }
+    m_v_clst(g.get_nb_vertices())
+{
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    if (!f)
+    {
+        std::cerr << "[ERROR] Clustering: it was not possible to open " <<
+            path << ".\n";
+        exit(EXIT_FAILURE);
     }
+    std::string content(static_cast<std::size_t>(f.tellg()), '\0');
+    f.seekg(0);
+    f.read(&content[0], content.size());
     f.close();
+
+    // the file is split in chunks of whole lines that are parsed in parallel
+    const long long nb_chunks = std::max<long long>(1, std::min<long long>(
+        content.size() / min_chunk_size,
+        std::max(1, omp_get_max_threads()) * parts_per_thread));
+    std::vector<std::size_t> chunk_begin(nb_chunks + 1, content.size());
+    chunk_begin[0] = 0;
+    for (long long i = 1; i < nb_chunks; ++i)
+    {
+        std::size_t pos = std::max<std::size_t>(chunk_begin[i - 1],
+            content.size() * i / nb_chunks);
+        pos = content.find('\n', pos == 0 ? 0 : pos - 1);
+        chunk_begin[i] = pos == std::string::npos ? content.size() : pos + 1;
+    }
+
+    std::vector<std::vector<Cluster>> chunk_clsts(nb_chunks);
+    std::vector<char> valid(nb_chunks, true);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long long i = 0; i < nb_chunks; ++i)
+    {
+        valid[i] = parse_clusters(g, content.data() + chunk_begin[i],
+            content.data() + chunk_begin[i + 1], chunk_clsts[i]);
+    }
+    if (std::find(valid.begin(), valid.end(), false) != valid.end())
+    {
+        std::cerr << "[ERROR] Clustering: invalid vertex in " << path <<
+            ".\n";
+        exit(EXIT_FAILURE);
+    }
+    std::string().swap(content);
+
+    // the clusters ids follow the lines order
+    std::vector<Cluster> clusters;
+    std::size_t nb_clsts = 0;
+    for (const auto &chunk : chunk_clsts)
+    {
+        nb_clsts += chunk.size();
+    }
+    clusters.reserve(nb_clsts);
+    for (auto &chunk : chunk_clsts)
+    {
+        std::move(chunk.begin(), chunk.end(), std::back_inserter(clusters));
+        std::vector<Cluster>().swap(chunk);
+    }
+    insert(std::move(clusters));
 }
 
 
@@ -75,11 +257,27 @@ std::unordered_map<unsigned int, Cluster>::const_iterator
 }
 
 
+bool Clustering::contains(const Cluster &c) const
+{
+    auto range = m_fp_index.equal_range(c.get_fingerprint());
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        const Cluster &other = m_id_clst_map.at(it->second);
+        // fingerprints may collide: the vertices are compared to be sure
+        if (other.size() == c.size() && other == c)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
 bool Clustering::are_all_vertices_clustered() const
 {
-    for (unsigned int i = 0; i < m_v_clst.size(); ++i)
+    for (unsigned int i = 0; i < m_v_clst.nb_vertices(); ++i)
     {
-        if (m_v_clst[i].size() == 0)
+        if (m_v_clst.row_size(i) == 0)
         {
             return false;
         }
@@ -98,26 +296,16 @@ const Cluster& Clustering::get_cluster(const unsigned int id)
 unsigned int Clustering::get_inter_size(const unsigned int c1_id,
     const unsigned int c2_id) const
 {
-    if (m_id_ovlp_clsts_map.at(c1_id).find(c2_id) ==
-        m_id_ovlp_clsts_map.at(c1_id).end())
-    {
-        return 0;
-    }
-
-    if (m_id_ovlp_clsts_map.at(c1_id).at(c2_id) !=
-        m_id_ovlp_clsts_map.at(c2_id).at(c1_id))
-    {
-        std::cerr << "Clustering::get_inter_size: different size!\n";
-        exit(EXIT_FAILURE);
-    }
-
-    return m_id_ovlp_clsts_map.at(c1_id).at(c2_id);
+    compute_ovlps();
+    auto it = m_id_ovlp_clsts_map.at(c1_id).find(c2_id);
+    return it == m_id_ovlp_clsts_map.at(c1_id).end() ? 0 : it->second;
 }
 
 
 unsigned int Clustering::get_nb_ovlp_clsts(const unsigned int c_id) const
 {
     assert(c_id < m_id_upper_bound);
+    compute_ovlps();
     return m_id_ovlp_clsts_map.at(c_id).size();
 }
 
@@ -129,26 +317,25 @@ std::pair<
 Clustering::get_ovlp_clsts(const unsigned int c_id)
 {
     assert(c_id < m_id_upper_bound);
-    return std::make_pair(m_id_ovlp_clsts_map.at(c_id).begin(),
-        m_id_ovlp_clsts_map.at(c_id).end());
+    compute_ovlps();
+    return std::make_pair(m_id_ovlp_clsts_map.at(c_id).cbegin(),
+        m_id_ovlp_clsts_map.at(c_id).cend());
 }
 
 
 std::pair<
-    std::unordered_set<unsigned int>::const_iterator,
-    std::unordered_set<unsigned int>::const_iterator
+    std::vector<unsigned int>::const_iterator,
+    std::vector<unsigned int>::const_iterator
     > 
 Clustering::get_v_belonging(const unsigned int v) const
 {
-    assert(v < m_v_clst.size());
-    return std::make_pair(m_v_clst[v].begin(), m_v_clst[v].end());
+    return m_v_clst.row(v);
 }
 
 
 unsigned int Clustering::get_v_belonging_size(const unsigned int v) const
 {
-    assert(v < m_v_clst.size());
-    return m_v_clst[v].size();
+    return m_v_clst.row_size(v);
 }
 
 
@@ -157,14 +344,13 @@ unsigned int Clustering::insert(const Cluster &c)
     unsigned int current_id = m_id_upper_bound++;
     
     m_id_clst_map.insert(std::make_pair(current_id, c));
-    m_id_ovlp_clsts_map.insert({current_id,
-        std::unordered_map<unsigned int, unsigned int>()});
-
     for (auto v : c)
     {
-        insert_v_belonging(v, current_id);
+        m_v_clst.insert(v, current_id);
     }
+    m_fp_index.emplace(c.get_fingerprint(), current_id);
 
+    m_updated_ovlps = false;
     return current_id;
 }
 
@@ -173,26 +359,50 @@ unsigned int Clustering::insert(const Cluster &&c)
 {
     unsigned int current_id = m_id_upper_bound++;
     m_id_clst_map.emplace(std::make_pair(current_id, c));
-    m_id_ovlp_clsts_map.insert({current_id,
-        std::unordered_map<unsigned int, unsigned int>()});
-
     for (auto v : c)
     {
-        insert_v_belonging(v, current_id);
+        m_v_clst.insert(v, current_id);
     }
+    m_fp_index.emplace(c.get_fingerprint(), current_id);
 
+    m_updated_ovlps = false;
     return current_id;
 }
 
 
+void Clustering::insert(std::vector<Cluster> &&clusters)
+{
+    const unsigned int first_id = m_id_upper_bound;
+    m_id_upper_bound += clusters.size();
+
+    std::vector<unsigned int> c_ids;
+    std::vector<Membership_index::vertices_range> vertices;
+    c_ids.reserve(clusters.size());
+    vertices.reserve(clusters.size());
+    m_id_clst_map.reserve(m_id_clst_map.size() + clusters.size());
+    m_fp_index.reserve(m_fp_index.size() + clusters.size());
+    for (unsigned int i = 0; i < clusters.size(); ++i)
+    {
+        // map nodes are stable, so the ranges remain valid
+        clusters[i].release_degrees();
+        auto it = m_id_clst_map.emplace(first_id + i, std::move(clusters[i]));
+        m_fp_index.emplace(it.first->second.get_fingerprint(), first_id + i);
+        c_ids.push_back(first_id + i);
+        vertices.push_back(std::make_pair(it.first->second.begin(),
+            it.first->second.end()));
+    }
+    clusters.clear();
+
+    m_v_clst.append(c_ids, vertices);
+    m_updated_ovlps = false;
+}
+
+
 bool Clustering::insert_without_repetition(const Cluster &c)
 {
-    for (const auto &id_c : m_id_clst_map)
+    if (contains(c))
     {
-        if (id_c.second == c)
-        {
-            return false;
-        }
+        return false;
     }
 
     insert(c);
@@ -203,22 +413,58 @@ bool Clustering::insert_without_repetition(const Cluster &c)
 bool Clustering::insert_v_in_clst(const unsigned int v, 
     const unsigned int c_id)
 {
-    assert(v < m_v_clst.size() && c_id < m_id_upper_bound);
+    assert(v < m_v_clst.nb_vertices() && c_id < m_id_upper_bound);
 
-    bool inserted = m_id_clst_map.at(c_id).insert(v);
+    Cluster &c = m_id_clst_map.at(c_id);
+    const std::uint64_t old_fp = c.get_fingerprint();
+    bool inserted = c.insert(v);
     if (inserted)
     {
-        for (auto oc_id : m_v_clst[v]) // update overlapping clst "lists"
-        {
-            insert_ovlp_clst(c_id, oc_id);
-        }
-        m_v_clst[v].insert(c_id);
+        m_v_clst.insert(v, c_id);
+        reindex_fingerprint(c_id, old_fp);
+        m_updated_ovlps = false;
     }
 
     return inserted;
 }
 
 
+void Clustering::insert_vs_in_clsts(
+    std::vector<std::pair<unsigned int, std::vector<unsigned int>>> &&batch)
+{
+    const long long batch_size = static_cast<long long>(batch.size());
+    std::vector<unsigned int> c_ids(batch.size());
+    std::vector<Membership_index::vertices_range> vertices(batch.size());
+    std::vector<std::uint64_t> old_fps(batch.size());
+
+    // each cluster appears once in the batch, so they are merged in parallel
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (long long i = 0; i < batch_size; ++i)
+    {
+        Cluster &c = m_id_clst_map.at(batch[i].first);
+        old_fps[i] = c.get_fingerprint();
+        auto &vs = batch[i].second;
+        std::sort(vs.begin(), vs.end());
+        vs.erase(std::unique(vs.begin(), vs.end()), vs.end());
+        vs.erase(std::remove_if(vs.begin(), vs.end(),
+            [&](const unsigned int v)
+            {
+                return c.contains(v);
+            }), vs.end());
+        c.insert(vs);
+        c_ids[i] = batch[i].first;
+        vertices[i] = std::make_pair(vs.cbegin(), vs.cend());
+    }
+
+    m_v_clst.append(c_ids, vertices);
+    for (std::size_t i = 0; i < c_ids.size(); ++i)
+    {
+        reindex_fingerprint(c_ids[i], old_fps[i]);
+    }
+    m_updated_ovlps = false;
+}
+
+
 void Clustering::remove_clst(const unsigned int c_id)
 {
     assert(c_id < m_id_upper_bound);
@@ -230,71 +476,53 @@ void Clustering::remove_clst(const unsigned int c_id)
 
     for (auto v : m_id_clst_map.at(c_id))
     {
-        m_v_clst[v].erase(c_id);
-    }
-
-    for (auto oc_id : m_id_ovlp_clsts_map.at(c_id))
-    {
-        remove_ovlp_clst(oc_id.first, c_id); // remove c from oc ovlp list
+        m_v_clst.erase(v, c_id);
     }
 
+    unindex_fingerprint(c_id, m_id_clst_map.at(c_id).get_fingerprint());
     m_id_clst_map.erase(c_id);
-    m_id_ovlp_clsts_map.erase(c_id);
+    m_updated_ovlps = false;
 }
 
 
 bool Clustering::remove_v_from_clst(const unsigned int v, 
     const unsigned int c_id)
 {
-    assert(v < m_v_clst.size() && c_id < m_id_upper_bound);
+    assert(v < m_v_clst.nb_vertices() && c_id < m_id_upper_bound);
 
-    bool removed = m_id_clst_map.at(c_id).remove(v);
+    Cluster &c = m_id_clst_map.at(c_id);
+    const std::uint64_t old_fp = c.get_fingerprint();
+    bool removed = c.remove(v);
     if (removed)
     {
-        m_v_clst[v].erase(c_id);
-        for (auto oc_id : m_v_clst[v])
-        {
-            --m_id_ovlp_clsts_map.at(c_id).at(oc_id);
-            --m_id_ovlp_clsts_map.at(oc_id).at(c_id);
-            if (m_id_ovlp_clsts_map.at(c_id).at(oc_id) == 0 && 
-                m_id_ovlp_clsts_map.at(oc_id).at(c_id) == 0)
-            {
-                remove_ovlp_clst(c_id, oc_id);
-                remove_ovlp_clst(oc_id, c_id);
-            }
-        }
+        m_v_clst.erase(v, c_id);
+        reindex_fingerprint(c_id, old_fp);
+        m_updated_ovlps = false;
     }
 
     return removed;
 }
 
 
-std::unordered_set<unsigned int>::const_iterator
+std::vector<unsigned int>::const_iterator
     Clustering::remove_v_from_clst(
-        const std::unordered_set<unsigned int>::const_iterator itv,
+        const std::vector<unsigned int>::const_iterator itv,
         const unsigned int c_id)
 {
-    assert(*itv < m_v_clst.size() && c_id < m_id_upper_bound);
+    const unsigned int v = *itv; // itv is invalidated by the removal
+    assert(v < m_v_clst.nb_vertices() && c_id < m_id_upper_bound);
 
-    if (!m_id_clst_map.at(c_id).contains(*itv))
+    if (!m_id_clst_map.at(c_id).contains(v))
     {
         return m_id_clst_map.at(c_id).end();
     }
 
+    const std::uint64_t old_fp = m_id_clst_map.at(c_id).get_fingerprint();
     auto itr = m_id_clst_map.at(c_id).remove(itv); // iterator to return
 
-    m_v_clst[*itv].erase(c_id);
-    for (auto oc_id : m_v_clst[*itv])
-    {
-        --m_id_ovlp_clsts_map.at(c_id).at(oc_id);
-        --m_id_ovlp_clsts_map.at(oc_id).at(c_id);
-        if (m_id_ovlp_clsts_map.at(c_id).at(oc_id) == 0 &&
-            m_id_ovlp_clsts_map.at(oc_id).at(c_id) == 0)
-        {
-            remove_ovlp_clst(c_id, oc_id);
-            remove_ovlp_clst(oc_id, c_id);
-        }
-    }
+    m_v_clst.erase(v, c_id);
+    reindex_fingerprint(c_id, old_fp);
+    m_updated_ovlps = false;
 
     return itr;
 }
@@ -303,7 +531,7 @@ std::unordered_set<unsigned int>::const_iterator
 void Clustering::reserve(const unsigned int size)
 {
     m_id_clst_map.reserve(size);
-    m_id_ovlp_clsts_map.reserve(size);
+    m_fp_index.reserve(size);
 }
 
 
@@ -315,77 +543,203 @@ unsigned int Clustering::size() const
 
 void Clustering::write_clusters_in_file(const std::string &path) const
 {
-    std::ofstream f(path, std::fstream::trunc);
+    std::ofstream f(path, std::ios::binary | std::fstream::trunc);
+    if (!f)
+    {
+        std::cerr << "[ERROR] Clustering::write_clusters_in_file: it was not "
+            "possible to open " << path << ".\n";
+        exit(EXIT_FAILURE);
+    }
 
+    std::vector<const Cluster*> clusters;
+    clusters.reserve(m_id_clst_map.size());
     for (const auto &id_c : m_id_clst_map)
     {
-        const Cluster &c = id_c.second;
-        std::string sep = "";
-        for (auto v : c)
+        clusters.push_back(&id_c.second);
+    }
+
+    // clusters are written in blocks of about write_block_size memberships
+    std::size_t first = 0;
+    while (first < clusters.size())
+    {
+        std::size_t last = first;
+        std::size_t block_size = 0;
+        while (last < clusters.size() && block_size < write_block_size)
+        {
+            block_size += clusters[last++]->size() + 1;
+        }
+
+        // each part of the block is formatted by a thread in its own buffer
+        const long long nb_parts = std::min<long long>(last - first,
+            std::max(1, omp_get_max_threads()) * parts_per_thread);
+        std::vector<std::string> buffers(nb_parts);
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (long long p = 0; p < nb_parts; ++p)
         {
-            f << sep << v;
-            sep = " ";
+            const std::size_t p_first = first + (last - first) * p / nb_parts;
+            const std::size_t p_last = first + (last - first) * (p + 1) /
+                nb_parts;
+            format_clusters(clusters, p_first, p_last, buffers[p]);
         }
-        f << "\n";
+
+        for (const auto &buffer : buffers)
+        {
+            f.write(buffer.data(), buffer.size());
+        }
+        first = last;
     }
 
     f.close();
+    if (!f)
+    {
+        std::cerr << "[ERROR] Clustering::write_clusters_in_file: it was not "
+            "possible to write " << path << ".\n";
+        exit(EXIT_FAILURE);
+    }
 }
 
 
-/////////////////////////////// private methods ////////////////////////////////
-
-
-bool Clustering::insert_ovlp_clst(const unsigned int c_id, 
-    const unsigned int oc_id)
+void Clustering::write_clusters_in_binary_file(const std::string &path) const
 {
-    assert(c_id < m_id_upper_bound && oc_id < m_id_upper_bound);
+    std::ofstream f(path, std::ios::binary | std::fstream::trunc);
+    if (!f)
+    {
+        std::cerr << "[ERROR] Clustering::write_clusters_in_binary_file: it was "
+            "not possible to open " << path << ".\n";
+        exit(EXIT_FAILURE);
+    }
 
-    if (m_id_ovlp_clsts_map.at(c_id).find(oc_id) ==
-        m_id_ovlp_clsts_map.at(c_id).end() &&
-        m_id_ovlp_clsts_map.at(oc_id).find(c_id) ==
-        m_id_ovlp_clsts_map.at(oc_id).end()) // if not already inserted
+    // the clusters are numbered in the map order (as in the text file)
+    const unsigned int nb_vertices = m_v_clst.nb_vertices();
+    std::vector<std::uint64_t> cluster_offsets(1, 0);
+    cluster_offsets.reserve(m_id_clst_map.size() + 1);
+    std::vector<unsigned int> position(m_id_upper_bound, 0);
+    for (const auto &id_c : m_id_clst_map)
     {
-        // insert in both clusters list with 1 as the number of sharing vertices
-        return m_id_ovlp_clsts_map.at(c_id).insert({oc_id, 1}).second &&
-            m_id_ovlp_clsts_map.at(oc_id).insert({c_id, 1}).second; // inserted
+        position[id_c.first] = cluster_offsets.size() - 1;
+        cluster_offsets.push_back(cluster_offsets.back() + id_c.second.size());
     }
-    else if (m_id_ovlp_clsts_map.at(c_id).find(oc_id) !=
-        m_id_ovlp_clsts_map.at(c_id).end() &&
-        m_id_ovlp_clsts_map.at(oc_id).find(c_id) !=
-        m_id_ovlp_clsts_map.at(oc_id).end()) // if already inserted
+    const std::uint64_t nb_clsts = m_id_clst_map.size();
+    const std::uint64_t nb_memberships = cluster_offsets.back();
+
+    // inverse index: clusters positions of each vertex
+    std::vector<std::uint64_t> vertex_offsets(nb_vertices + 1, 0);
+    for (unsigned int v = 0; v < nb_vertices; ++v)
     {
-        // increment by 1 the number of sharing vertices
-        ++m_id_ovlp_clsts_map.at(c_id).at(oc_id);
-        ++m_id_ovlp_clsts_map.at(oc_id).at(c_id);
-        return false; // not inserted
+        vertex_offsets[v + 1] = vertex_offsets[v] + m_v_clst.row_size(v);
     }
-    else // error: we have some problem here TODO: implement
+    std::vector<std::uint32_t> vertex_clusters(nb_memberships);
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (long long v = 0; v < nb_vertices; ++v)
     {
-        std::cerr << "Error: Clustering::insert_ovlp_clst\n";
-        std::cin.get();
-        return false;
+        auto row = m_v_clst.row(v);
+        auto out = vertex_clusters.begin() + vertex_offsets[v];
+        for (auto it = row.first; it != row.second; ++it)
+        {
+            *out++ = position[*it];
+        }
+        std::sort(vertex_clusters.begin() + vertex_offsets[v], out);
+    }
+
+    const char magic[8] = {'N', 'I', 'S', 'E', 'C', 'L', 'S', 'T'};
+    const std::uint32_t version = binary_format_version;
+    const std::uint32_t n = nb_vertices;
+    f.write(magic, sizeof(magic));
+    write_binary(f, &version, 1);
+    write_binary(f, &n, 1);
+    write_binary(f, &nb_clsts, 1);
+    write_binary(f, &nb_memberships, 1);
+    write_binary(f, cluster_offsets.data(), cluster_offsets.size());
+    // the vertices of a cluster are kept sorted in a contiguous vector
+    static_assert(sizeof(unsigned int) == sizeof(std::uint32_t),
+        "vertices must be 32-bit integers");
+    for (const auto &id_c : m_id_clst_map)
+    {
+        if (!id_c.second.empty())
+        {
+            write_binary(f, &*id_c.second.begin(), id_c.second.size());
+        }
+    }
+    const std::uint32_t padding = 0;
+    write_binary(f, &padding, nb_memberships % 2);
+    write_binary(f, vertex_offsets.data(), vertex_offsets.size());
+    write_binary(f, vertex_clusters.data(), vertex_clusters.size());
+
+    f.close();
+    if (!f)
+    {
+        std::cerr << "[ERROR] Clustering::write_clusters_in_binary_file: it was "
+            "not possible to write " << path << ".\n";
+        exit(EXIT_FAILURE);
     }
 }
 
 
-bool Clustering::insert_v_belonging(const unsigned int v, 
-    const unsigned int c_id)
+/////////////////////////////// private methods ////////////////////////////////
+
+
+void Clustering::compute_ovlps() const
 {
-    assert(v < m_v_clst.size());
+    if (m_updated_ovlps)
+    {
+        return;
+    }
+
+    std::vector<unsigned int> ids;
+    ids.reserve(m_id_clst_map.size());
+    for (const auto &id_c : m_id_clst_map)
+    {
+        ids.push_back(id_c.first);
+    }
+
+    // each thread fills the overlap rows of its own clusters by a pass over
+    // the clusters that their vertices belong to (see m_v_clst)
+    std::vector<std::unordered_map<unsigned int, unsigned int>> rows(ids.size());
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+        for (auto v : m_id_clst_map.at(ids[i]))
+        {
+            auto v_clsts = m_v_clst.row(v);
+            for (auto it = v_clsts.first; it != v_clsts.second; ++it)
+            {
+                if (*it != ids[i])
+                {
+                    ++rows[i][*it];
+                }
+            }
+        }
+    }
 
-    for (auto oc : m_v_clst[v])
+    m_id_ovlp_clsts_map.clear();
+    m_id_ovlp_clsts_map.reserve(ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i)
     {
-        insert_ovlp_clst(oc, c_id);
+        m_id_ovlp_clsts_map.emplace(ids[i], std::move(rows[i]));
     }
 
-    return m_v_clst[v].insert(c_id).second;
+    m_updated_ovlps = true;
+}
+
+
+void Clustering::reindex_fingerprint(const unsigned int c_id,
+    const std::uint64_t old_fp)
+{
+    unindex_fingerprint(c_id, old_fp);
+    m_fp_index.emplace(m_id_clst_map.at(c_id).get_fingerprint(), c_id);
 }
 
 
-void Clustering::remove_ovlp_clst(const unsigned int c_id,
-    const unsigned int oc_id)
+void Clustering::unindex_fingerprint(const unsigned int c_id,
+    const std::uint64_t fp)
 {
-    assert(c_id < m_id_upper_bound && oc_id < m_id_upper_bound);
-    m_id_ovlp_clsts_map.at(c_id).erase(oc_id);
-}
\ No newline at end of file
+    auto range = m_fp_index.equal_range(fp);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second == c_id)
+        {
+            m_fp_index.erase(it);
+            return;
+        }
+    }
+}
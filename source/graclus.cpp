@@ -0,0 +1,614 @@
+/*
+ * File: graclus.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Implementation of the multilevel weighted kernel k-means clustering
+ * (Graclus) [1].
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 10:25 AM
+ *
+ * References:
+ * [1] I. S. Dhillon, Y. Guan and B. Kulis. Weighted graph cuts without
+ * eigenvectors a multilevel approach, IEEE Transactions on Pattern Analysis and
+ * Machine Intelligence 29(11) (2007) p. 1944-1957.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <numeric>
+#include <queue>
+#include <random>
+#include "../headers/graclus.hpp"
+
+
+/////////////////////////////// Helper functions ///////////////////////////////
+
+namespace
+{
+
+/**
+ * @brief The coarsening stops when the graph has at most
+ * max(min_coarse_size, coarsen_factor * k) vertices (see [1]).
+*/
+const unsigned int coarsen_factor = 5; // magic number
+const unsigned int min_coarse_size = 20; // magic number
+
+/**
+ * @brief The coarsening also stops when a level keeps more than this rate of
+ * the vertices of the previous level, i.e., when the matching stalls.
+*/
+const double max_coarsening_rate = 0.95; // magic number
+
+/**
+ * @brief Number of rounds of the parallel (handshake) heavy-edge matching.
+*/
+const unsigned int nb_matching_rounds = 4; // magic number
+
+/**
+ * @brief Kernel k-means stops after this number of iterations or when less than
+ * min_moves_rate * |V| vertices change of cluster.
+*/
+const unsigned int max_kkmeans_iterations = 10; // magic number
+const double min_moves_rate = 1e-3; // magic number
+
+/**
+ * @brief Seed of the region growing (base clustering) random generator. It is
+ * fixed so the seeding is reproducible.
+*/
+const unsigned int region_growing_seed = 0;
+
+/**
+ * @brief Weighted graph in compressed sparse row format used through all
+ * levels of the multilevel clustering. Edges collapsed by the coarsening are
+ * kept as self-loops weights and the vertex weight is its weighted degree
+ * (including the self-loop), as required by the normalized cut kernel [1].
+*/
+struct weighted_graph
+{
+    std::vector<std::size_t> offsets;
+    std::vector<unsigned int> adj;
+    std::vector<double> weights;
+    std::vector<double> self_weight;
+    std::vector<double> vtx_weight;
+
+    unsigned int nb_vertices() const
+    {
+        return vtx_weight.size();
+    }
+};
+
+/**
+* @brief Convert the input graph to the weighted CSR format. All edges have
+* weight 1.
+* @param const Graph &: input graph.
+* @return weighted_graph: finest level graph.
+*/
+weighted_graph to_weighted_graph(const Graph &g)
+{
+    const unsigned int n = g.get_nb_vertices();
+    weighted_graph wg;
+    wg.offsets.assign(n + 1, 0);
+    for (unsigned int v = 0; v < n; ++v)
+    {
+        wg.offsets[v + 1] = wg.offsets[v] + g.get_vtx_degree(v);
+    }
+    wg.adj.resize(wg.offsets[n]);
+    wg.weights.assign(wg.offsets[n], 1.0);
+    wg.self_weight.assign(n, 0);
+    wg.vtx_weight.resize(n);
+
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (unsigned int v = 0; v < n; ++v)
+    {
+        auto adj_list = g.adj_list_of_vtx(v);
+        std::copy(adj_list.first, adj_list.second,
+            wg.adj.begin() + wg.offsets[v]);
+        wg.vtx_weight[v] = static_cast<double>(g.get_vtx_degree(v));
+    }
+
+    return wg;
+}
+
+/**
+* @brief Parallel heavy-edge matching for the normalized cut (see [1]). In each
+* round every unmatched vertex points to the unmatched neighbor u that
+* maximizes e(v,u)/w(v) + e(v,u)/w(u), and mutual pointers become matched.
+* @param const weighted_graph &: graph to be matched.
+* @return std::vector<unsigned int>: matched vertex of each vertex (a vertex
+* left unmatched is matched with itself).
+*/
+std::vector<unsigned int> heavy_edge_matching(const weighted_graph &wg)
+{
+    const unsigned int n = wg.nb_vertices();
+    const unsigned int unmatched = n; // invalid vertex index
+    std::vector<unsigned int> match(n, unmatched);
+    std::vector<unsigned int> pref(n, unmatched);
+
+    for (unsigned int round = 0; round < nb_matching_rounds; ++round)
+    {
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (unsigned int v = 0; v < n; ++v)
+        {
+            pref[v] = unmatched;
+            if (match[v] != unmatched)
+            {
+                continue;
+            }
+            double best = 0;
+            for (auto i = wg.offsets[v]; i < wg.offsets[v + 1]; ++i)
+            {
+                const unsigned int u = wg.adj[i];
+                if (match[u] != unmatched)
+                {
+                    continue;
+                }
+                double score = wg.weights[i] / wg.vtx_weight[v] +
+                    wg.weights[i] / wg.vtx_weight[u];
+                if (score > best || (score == best && u < pref[v]))
+                {
+                    best = score;
+                    pref[v] = u;
+                }
+            }
+        }
+
+        unsigned int nb_matched = 0;
+        #pragma omp parallel for reduction(+:nb_matched)
+        for (unsigned int v = 0; v < n; ++v)
+        {
+            if (match[v] == unmatched && pref[v] != unmatched &&
+                pref[pref[v]] == v)
+            {
+                match[v] = pref[v];
+                ++nb_matched;
+            }
+        }
+
+        if (nb_matched == 0)
+        {
+            break;
+        }
+    }
+
+    for (unsigned int v = 0; v < n; ++v)
+    {
+        if (match[v] == unmatched)
+        {
+            match[v] = v;
+        }
+    }
+
+    return match;
+}
+
+/**
+* @brief Build the coarse graph by collapsing each matched pair of vertices in a
+* single vertex. Parallel edges are merged by summing their weights and the
+* edges between matched vertices become self-loops.
+* @param const weighted_graph &: fine graph.
+* @param const std::vector<unsigned int> &: matching of the fine graph.
+* @param std::vector<unsigned int> &: output coarse vertex of each fine vertex.
+* @return weighted_graph: coarse graph.
+*/
+weighted_graph coarsen(const weighted_graph &wg,
+    const std::vector<unsigned int> &match, std::vector<unsigned int> &cmap)
+{
+    const unsigned int n = wg.nb_vertices();
+    cmap.assign(n, 0);
+    std::vector<unsigned int> leader; // smallest fine vertex of coarse vertex
+    leader.reserve(n);
+    for (unsigned int v = 0; v < n; ++v)
+    {
+        if (v <= match[v])
+        {
+            cmap[v] = leader.size();
+            leader.push_back(v);
+        }
+    }
+    for (unsigned int v = 0; v < n; ++v)
+    {
+        if (v > match[v])
+        {
+            cmap[v] = cmap[match[v]];
+        }
+    }
+
+    const unsigned int nc = leader.size();
+    weighted_graph cg;
+    cg.self_weight.assign(nc, 0);
+    cg.vtx_weight.assign(nc, 0);
+    std::vector<std::vector<std::pair<unsigned int, double>>> cadj(nc);
+
+    #pragma omp parallel
+    {
+        // sparse accumulator: position of a coarse neighbor in cadj[c]
+        std::vector<unsigned int> pos(nc, nc);
+        #pragma omp for schedule(dynamic, 512)
+        for (unsigned int c = 0; c < nc; ++c)
+        {
+            const unsigned int members[2] = {leader[c], match[leader[c]]};
+            const unsigned int nb_members = members[0] == members[1] ? 1 : 2;
+            for (unsigned int m = 0; m < nb_members; ++m)
+            {
+                const unsigned int v = members[m];
+                cg.self_weight[c] += wg.self_weight[v];
+                cg.vtx_weight[c] += wg.vtx_weight[v];
+                for (auto i = wg.offsets[v]; i < wg.offsets[v + 1]; ++i)
+                {
+                    const unsigned int cu = cmap[wg.adj[i]];
+                    if (cu == c)
+                    {
+                        cg.self_weight[c] += wg.weights[i];
+                    }
+                    else if (pos[cu] == nc)
+                    {
+                        pos[cu] = cadj[c].size();
+                        cadj[c].emplace_back(cu, wg.weights[i]);
+                    }
+                    else
+                    {
+                        cadj[c][pos[cu]].second += wg.weights[i];
+                    }
+                }
+            }
+            for (const auto &e : cadj[c])
+            {
+                pos[e.first] = nc; // reset accumulator
+            }
+        }
+    }
+
+    cg.offsets.assign(nc + 1, 0);
+    for (unsigned int c = 0; c < nc; ++c)
+    {
+        cg.offsets[c + 1] = cg.offsets[c] + cadj[c].size();
+    }
+    cg.adj.resize(cg.offsets[nc]);
+    cg.weights.resize(cg.offsets[nc]);
+
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (unsigned int c = 0; c < nc; ++c)
+    {
+        auto i = cg.offsets[c];
+        for (const auto &e : cadj[c])
+        {
+            cg.adj[i] = e.first;
+            cg.weights[i++] = e.second;
+        }
+    }
+
+    return cg;
+}
+
+/**
+* @brief Base clustering of the coarsest graph by region growing: k random
+* vertices are the initial regions, which grow by a multi-source breadth-first
+* search (see [1]).
+* @param const weighted_graph &: coarsest graph.
+* @param const unsigned int: number of clusters (k <= |V|).
+* @return std::vector<unsigned int>: cluster label of each vertex.
+*/
+std::vector<unsigned int> region_growing(const weighted_graph &wg,
+    const unsigned int k)
+{
+    const unsigned int n = wg.nb_vertices();
+    std::vector<unsigned int> labels(n, k); // k is the unassigned label
+    std::vector<unsigned int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::mt19937 rng(region_growing_seed);
+    std::shuffle(order.begin(), order.end(), rng);
+
+    std::queue<unsigned int> q;
+    for (unsigned int c = 0; c < k; ++c)
+    {
+        labels[order[c]] = c;
+        q.push(order[c]);
+    }
+
+    while (!q.empty())
+    {
+        const unsigned int v = q.front();
+        q.pop();
+        for (auto i = wg.offsets[v]; i < wg.offsets[v + 1]; ++i)
+        {
+            if (labels[wg.adj[i]] == k)
+            {
+                labels[wg.adj[i]] = labels[v];
+                q.push(wg.adj[i]);
+            }
+        }
+    }
+
+    // vertices unreachable from the initial regions (other components)
+    unsigned int c = 0;
+    for (auto &l : labels)
+    {
+        if (l == k)
+        {
+            l = c++ % k;
+        }
+    }
+
+    return labels;
+}
+
+/**
+* @brief Normalized association of the clustering, i.e., the objective
+* maximized by the kernel k-means (see [1]). The cluster weights and links are
+* computed as a by-product.
+* @param const weighted_graph &: graph.
+* @param const std::vector<unsigned int> &: cluster label of each vertex.
+* @param std::vector<double> &: output weight (volume) of each cluster.
+* @param std::vector<double> &: output internal links of each cluster.
+* @return double: sum over clusters of links(c, c) / w(c).
+*/
+double cluster_stats(const weighted_graph &wg,
+    const std::vector<unsigned int> &labels, std::vector<double> &clst_w,
+    std::vector<double> &clst_links)
+{
+    const unsigned int n = wg.nb_vertices();
+    const unsigned int k = clst_w.size();
+    std::fill(clst_w.begin(), clst_w.end(), 0);
+    std::fill(clst_links.begin(), clst_links.end(), 0);
+
+    #pragma omp parallel
+    {
+        std::vector<double> w(k, 0);
+        std::vector<double> links(k, 0);
+        #pragma omp for schedule(dynamic, 1024) nowait
+        for (unsigned int v = 0; v < n; ++v)
+        {
+            const unsigned int c = labels[v];
+            w[c] += wg.vtx_weight[v];
+            links[c] += wg.self_weight[v];
+            for (auto i = wg.offsets[v]; i < wg.offsets[v + 1]; ++i)
+            {
+                if (labels[wg.adj[i]] == c)
+                {
+                    links[c] += wg.weights[i];
+                }
+            }
+        }
+        #pragma omp critical
+        {
+            for (unsigned int c = 0; c < k; ++c)
+            {
+                clst_w[c] += w[c];
+                clst_links[c] += links[c];
+            }
+        }
+    }
+
+    double objective = 0;
+    for (unsigned int c = 0; c < k; ++c)
+    {
+        if (clst_w[c] > 0)
+        {
+            objective += clst_links[c] / clst_w[c];
+        }
+    }
+
+    return objective;
+}
+
+/**
+* @brief Refine the clustering by the batch weighted kernel k-means with the
+* normalized cut kernel (see [1]). The distance of vertex v to cluster c is
+* -2 links(v,c) / (w(v) w(c)) + links(c,c) / w(c)^2 (constant terms omitted).
+* The candidate clusters of v are its own and its neighbors' clusters. The
+* vertices distances are computed in parallel and the moves that would empty a
+* cluster are discarded. The refinement stops if the objective decreases.
+* @param const weighted_graph &: graph.
+* @param const unsigned int: number of clusters.
+* @param std::vector<unsigned int> &: cluster label of each vertex (updated).
+*/
+void kernel_kmeans(const weighted_graph &wg, const unsigned int k,
+    std::vector<unsigned int> &labels)
+{
+    const unsigned int n = wg.nb_vertices();
+    std::vector<unsigned int> clst_size(k, 0);
+    for (auto l : labels)
+    {
+        ++clst_size[l];
+    }
+
+    std::vector<double> clst_w(k);
+    std::vector<double> clst_links(k);
+    std::vector<unsigned int> new_labels(n);
+    std::vector<unsigned int> prev_labels;
+    double prev_objective = -std::numeric_limits<double>::infinity();
+
+    for (unsigned int iter = 0; iter < max_kkmeans_iterations; ++iter)
+    {
+        double objective = cluster_stats(wg, labels, clst_w, clst_links);
+        if (objective < prev_objective)
+        {
+            labels.swap(prev_labels); // undo the last iteration
+            break;
+        }
+        prev_objective = objective;
+
+        #pragma omp parallel
+        {
+            std::vector<double> acc(k, 0);
+            std::vector<char> seen(k, 0);
+            std::vector<unsigned int> touched;
+            #pragma omp for schedule(dynamic, 1024)
+            for (unsigned int v = 0; v < n; ++v)
+            {
+                const unsigned int own = labels[v];
+                new_labels[v] = own;
+                if (wg.vtx_weight[v] <= 0)
+                {
+                    continue;
+                }
+
+                auto visit = [&](const unsigned int c, const double w)
+                {
+                    if (!seen[c])
+                    {
+                        seen[c] = 1;
+                        touched.push_back(c);
+                    }
+                    acc[c] += w;
+                };
+                visit(own, wg.self_weight[v]);
+                for (auto i = wg.offsets[v]; i < wg.offsets[v + 1]; ++i)
+                {
+                    visit(labels[wg.adj[i]], wg.weights[i]);
+                }
+
+                auto dist = [&](const unsigned int c)
+                {
+                    return -2 * acc[c] / (wg.vtx_weight[v] * clst_w[c]) +
+                        clst_links[c] / (clst_w[c] * clst_w[c]);
+                };
+                double best_dist = dist(own);
+                for (auto c : touched)
+                {
+                    if (clst_w[c] > 0 && dist(c) < best_dist)
+                    {
+                        best_dist = dist(c);
+                        new_labels[v] = c;
+                    }
+                }
+
+                for (auto c : touched)
+                {
+                    acc[c] = 0;
+                    seen[c] = 0;
+                }
+                touched.clear();
+            }
+        }
+
+        prev_labels = labels;
+        unsigned int nb_moves = 0;
+        for (unsigned int v = 0; v < n; ++v)
+        {
+            if (new_labels[v] != labels[v] && clst_size[labels[v]] > 1)
+            {
+                --clst_size[labels[v]];
+                ++clst_size[new_labels[v]];
+                labels[v] = new_labels[v];
+                ++nb_moves;
+            }
+        }
+
+        if (nb_moves <= min_moves_rate * n)
+        {
+            break;
+        }
+    }
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+std::vector<unsigned int> utils::graclus::partition(const Graph &g,
+    const unsigned int k)
+{
+    const unsigned int n = g.get_nb_vertices();
+    if (k >= n)
+    {
+        std::vector<unsigned int> labels(n);
+        std::iota(labels.begin(), labels.end(), 0);
+        return labels; // each vertex is a cluster
+    }
+
+    // coarsening phase
+    std::vector<weighted_graph> levels;
+    std::vector<std::vector<unsigned int>> cmaps;
+    levels.push_back(to_weighted_graph(g));
+    const unsigned int coarse_size = std::max(min_coarse_size,
+        coarsen_factor * k);
+    while (levels.back().nb_vertices() > coarse_size)
+    {
+        std::vector<unsigned int> cmap;
+        auto match = heavy_edge_matching(levels.back());
+        weighted_graph cg = coarsen(levels.back(), match, cmap);
+        if (cg.nb_vertices() < k || cg.nb_vertices() >
+            max_coarsening_rate * levels.back().nb_vertices())
+        {
+            break;
+        }
+        levels.push_back(std::move(cg));
+        cmaps.push_back(std::move(cmap));
+    }
+
+    // base clustering phase
+    auto labels = region_growing(levels.back(), k);
+    kernel_kmeans(levels.back(), k, labels);
+
+    // refinement phase
+    for (auto l = levels.size() - 1; l > 0; --l)
+    {
+        const auto &cmap = cmaps[l - 1];
+        std::vector<unsigned int> fine_labels(levels[l - 1].nb_vertices());
+        #pragma omp parallel for
+        for (unsigned int v = 0; v < fine_labels.size(); ++v)
+        {
+            fine_labels[v] = labels[cmap[v]];
+        }
+        labels.swap(fine_labels);
+        kernel_kmeans(levels[l - 1], k, labels);
+    }
+
+    return labels;
+}
+
+
+std::vector<unsigned int> utils::graclus::centers(const Graph &g,
+    const std::vector<unsigned int> &labels)
+{
+    const unsigned int n = g.get_nb_vertices();
+    assert(labels.size() == n);
+
+    // links(v, c) / w(v): the larger it is, the closer v is to the centroid
+    std::vector<double> closeness(n, 0);
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (unsigned int v = 0; v < n; ++v)
+    {
+        unsigned int links = 0;
+        auto adj_list = g.adj_list_of_vtx(v);
+        for (auto it = adj_list.first; it != adj_list.second; ++it)
+        {
+            if (labels[*it] == labels[v])
+            {
+                ++links;
+            }
+        }
+        if (g.get_vtx_degree(v) > 0)
+        {
+            closeness[v] = static_cast<double>(links) / g.get_vtx_degree(v);
+        }
+    }
+
+    const unsigned int k = n > 0 ?
+        *std::max_element(labels.begin(), labels.end()) + 1 : 0;
+    std::vector<unsigned int> center(k, n); // n is the invalid vertex
+    for (unsigned int v = 0; v < n; ++v)
+    {
+        const unsigned int u = center[labels[v]];
+        if (u == n || closeness[v] > closeness[u] || (closeness[v] ==
+            closeness[u] && g.get_vtx_degree(v) > g.get_vtx_degree(u)))
+        {
+            center[labels[v]] = v;
+        }
+    }
+
+    std::vector<unsigned int> seeds;
+    seeds.reserve(k);
+    std::copy_if(center.begin(), center.end(), std::back_inserter(seeds),
+        [n](const unsigned int v)
+        {
+            return v != n;
+        });
+
+    return seeds;
+}
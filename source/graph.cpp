@@ -417,6 +417,12 @@ unsigned int Graph::get_vtx_id(const std::string &label) const
 }
 
 
+bool Graph::has_vtx_labels() const
+{
+    return !m_label_id_map.empty();
+}
+
+
 std::string Graph::get_vtx_label(const unsigned int v) const
 {
     assert(v < m_nb_vertices);
@@ -22,6 +22,8 @@
 
 #include "../headers/nise_parameters.hpp"
 #include "../headers/nise.hpp"
+#include "../headers/nise_server.hpp"
+#include "../headers/time_mgmt.hpp"
 
 
 int main(int argc, char** argv)
@@ -34,10 +36,23 @@ int main(int argc, char** argv)
         return EXIT_FAILURE;
     }
 
+    utils::time_mgmt tmgmt;
+    tmgmt.start();
     Graph g(params.get_graph_path());
+    tmgmt.end();
+
+    if (!params.get_socket_path().empty()) // server mode
+    {
+        Nise_server server(g, params);
+        return server.run() ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     Nise nise(g, params);
+    nise.report_phase("loading", tmgmt);
     nise.execute();
     nise.write_clustering();
+    nise.write_report();
+    nise.write_trace();
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
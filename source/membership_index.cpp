@@ -0,0 +1,204 @@
+/*
+ * File: membership_index.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Implementation of the vertex to clusters index.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 07:25 PM
+ */
+
+#include <algorithm>
+#include <cassert>
+#include "../headers/membership_index.hpp"
+
+
+/////////////////////////////// Helper functions ///////////////////////////////
+
+namespace
+{
+
+/**
+ * @brief Capacity of a row moved to the end of the array is
+ * max(min_row_capacity, growth_factor * size).
+*/
+const unsigned int min_row_capacity = 2; // magic number
+const unsigned int growth_factor = 2; // magic number
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+Membership_index::Membership_index(const unsigned int nb_vertices) :
+    m_offset(nb_vertices, 0),
+    m_size(nb_vertices, 0),
+    m_capacity(nb_vertices, 0),
+    m_holes(0)
+{}
+
+
+void Membership_index::append(const std::vector<unsigned int> &c_ids,
+    const std::vector<vertices_range> &vertices)
+{
+    assert(c_ids.size() == vertices.size());
+    const long long nb_clsts = static_cast<long long>(c_ids.size());
+
+    // count the new memberships of each vertex
+    std::vector<unsigned int> count(m_size.size(), 0);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (long long i = 0; i < nb_clsts; ++i)
+    {
+        for (auto it = vertices[i].first; it != vertices[i].second; ++it)
+        {
+            #pragma omp atomic
+            ++count[*it];
+        }
+    }
+
+    // the old rows are copied contiguously with room for the new memberships
+    compact(count);
+
+    // fill the rows (each vertex has its own cursor)
+    std::vector<unsigned int> &cursor = m_size;
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (long long i = 0; i < nb_clsts; ++i)
+    {
+        for (auto it = vertices[i].first; it != vertices[i].second; ++it)
+        {
+            unsigned int pos;
+            #pragma omp atomic capture
+            pos = cursor[*it]++;
+            m_ids[m_offset[*it] + pos] = c_ids[i];
+        }
+    }
+
+    // sort the new part of each row and merge it with the old (sorted) part
+    const long long n = static_cast<long long>(m_size.size());
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (long long v = 0; v < n; ++v)
+    {
+        if (count[v] > 0)
+        {
+            auto first = m_ids.begin() + m_offset[v];
+            auto last = first + m_size[v];
+            std::sort(last - count[v], last);
+            std::inplace_merge(first, last - count[v], last);
+        }
+    }
+}
+
+
+bool Membership_index::erase(const unsigned int v, const unsigned int c_id)
+{
+    assert(v < m_size.size());
+
+    auto first = m_ids.begin() + m_offset[v];
+    auto last = first + m_size[v];
+    auto it = std::lower_bound(first, last, c_id);
+    if (it == last || *it != c_id)
+    {
+        return false;
+    }
+
+    std::copy(it + 1, last, it);
+    --m_size[v];
+    return true;
+}
+
+
+bool Membership_index::insert(const unsigned int v, const unsigned int c_id)
+{
+    assert(v < m_size.size());
+
+    auto first = m_ids.begin() + m_offset[v];
+    auto last = first + m_size[v];
+    auto it = std::lower_bound(first, last, c_id);
+    if (it != last && *it == c_id)
+    {
+        return false;
+    }
+
+    if (m_size[v] == m_capacity[v]) // move the row to the end of the array
+    {
+        std::size_t pos = it - first;
+        std::size_t new_offset = m_ids.size();
+        unsigned int new_capacity = std::max(min_row_capacity,
+            growth_factor * m_capacity[v]);
+        m_ids.resize(new_offset + new_capacity);
+        std::copy(m_ids.begin() + m_offset[v],
+            m_ids.begin() + m_offset[v] + m_size[v],
+            m_ids.begin() + new_offset);
+        m_holes += m_capacity[v];
+        m_offset[v] = new_offset;
+        m_capacity[v] = new_capacity;
+        first = m_ids.begin() + new_offset;
+        last = first + m_size[v];
+        it = first + pos;
+    }
+
+    std::copy_backward(it, last, last + 1);
+    *it = c_id;
+    ++m_size[v];
+
+    if (m_holes > m_ids.size() / 2)
+    {
+        compact(std::vector<unsigned int>());
+    }
+    return true;
+}
+
+
+unsigned int Membership_index::nb_vertices() const
+{
+    return m_size.size();
+}
+
+
+std::pair<
+    std::vector<unsigned int>::const_iterator,
+    std::vector<unsigned int>::const_iterator
+    >
+Membership_index::row(const unsigned int v) const
+{
+    assert(v < m_size.size());
+    auto first = m_ids.cbegin() + m_offset[v];
+    return std::make_pair(first, first + m_size[v]);
+}
+
+
+unsigned int Membership_index::row_size(const unsigned int v) const
+{
+    assert(v < m_size.size());
+    return m_size[v];
+}
+
+
+/////////////////////////////// private methods ////////////////////////////////
+
+
+void Membership_index::compact(const std::vector<unsigned int> &extra)
+{
+    const long long n = static_cast<long long>(m_size.size());
+    std::vector<std::size_t> offset(m_size.size(), 0);
+    std::size_t total = 0;
+    for (long long v = 0; v < n; ++v) // prefix sum of the new capacities
+    {
+        offset[v] = total;
+        m_capacity[v] = m_size[v] + (extra.empty() ? 0 : extra[v]);
+        total += m_capacity[v];
+    }
+
+    std::vector<unsigned int> ids(total);
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (long long v = 0; v < n; ++v)
+    {
+        std::copy(m_ids.begin() + m_offset[v],
+            m_ids.begin() + m_offset[v] + m_size[v], ids.begin() + offset[v]);
+    }
+
+    m_ids = std::move(ids);
+    m_offset = std::move(offset);
+    m_holes = 0;
+}
@@ -0,0 +1,248 @@
+/*
+ * File: minhash.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Implementation of the near-duplicate clusters detection by MinHash
+ * and LSH [1].
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 09:20 PM
+ *
+ * References:
+ * [1] J. Leskovec, A. Rajaraman and J. D. Ullman. Mining of Massive Datasets,
+ * 2nd ed. Cambridge University Press, 2014. Chapter 3.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include "../headers/minhash.hpp"
+
+
+/////////////////////////////// Helper functions ///////////////////////////////
+
+namespace
+{
+
+/**
+ * @brief Number of MinHash functions (sketch size).
+*/
+const unsigned int sketch_size = 128; // magic number
+
+/**
+ * @brief The LSH threshold (1/b)^(1/r) is kept below this rate of the Jaccard
+ * threshold, so pairs at the threshold are found with high probability.
+*/
+const double lsh_threshold_rate = 0.9; // magic number
+
+/**
+ * @brief Seed of the hash functions generator (fixed for reproducibility).
+*/
+const std::uint64_t hash_seed = 0x6d696e68617368ULL; // magic number
+
+typedef std::vector<std::uint64_t> sketch;
+
+/**
+ * @brief Mixing function (splitmix64 finalizer).
+*/
+std::uint64_t mix(std::uint64_t h)
+{
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+}
+
+/**
+ * @brief Choose the number of rows per band r (the number of bands is
+ * sketch_size / r): the largest r whose LSH threshold (1/b)^(1/r) is not
+ * greater than lsh_threshold_rate * threshold (see [1]).
+ * @param const double: Jaccard threshold.
+ * @return unsigned int: number of rows per band.
+*/
+unsigned int rows_per_band(const double threshold)
+{
+    unsigned int r = 1;
+    for (unsigned int i = 2; i <= sketch_size; ++i)
+    {
+        const double b = sketch_size / i;
+        if (std::pow(1.0 / b, 1.0 / i) > lsh_threshold_rate * threshold)
+        {
+            break;
+        }
+        r = i;
+    }
+    return r;
+}
+
+/**
+ * @brief Exact Jaccard similarity of two clusters (sorted vertices).
+*/
+double jaccard(const Cluster &c1, const Cluster &c2)
+{
+    unsigned int inter = 0;
+    auto it1 = c1.begin();
+    auto it2 = c2.begin();
+    while (it1 != c1.end() && it2 != c2.end())
+    {
+        if (*it1 < *it2)
+        {
+            ++it1;
+        }
+        else if (*it2 < *it1)
+        {
+            ++it2;
+        }
+        else
+        {
+            ++inter;
+            ++it1;
+            ++it2;
+        }
+    }
+    const unsigned int uni = c1.size() + c2.size() - inter;
+    return uni == 0 ? 1 : static_cast<double>(inter) / uni;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+std::vector<bool> utils::minhash::near_duplicates(
+    const std::vector<Cluster> &clusters, const double threshold)
+{
+    const long long n = static_cast<long long>(clusters.size());
+
+    // hash functions h_i(v) = mix(v ^ salt_i)
+    std::mt19937_64 rng(hash_seed);
+    std::vector<std::uint64_t> salts(sketch_size);
+    for (auto &s : salts)
+    {
+        s = rng();
+    }
+
+    // MinHash sketches
+    std::vector<sketch> sketches(clusters.size());
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (long long i = 0; i < n; ++i)
+    {
+        sketches[i].assign(sketch_size,
+            std::numeric_limits<std::uint64_t>::max());
+        for (auto v : clusters[i])
+        {
+            for (unsigned int h = 0; h < sketch_size; ++h)
+            {
+                sketches[i][h] = std::min(sketches[i][h], mix(v ^ salts[h]));
+            }
+        }
+    }
+
+    // LSH: candidate pairs share the bucket of at least one band
+    const unsigned int r = rows_per_band(threshold);
+    const int nb_bands = static_cast<int>(sketch_size / r);
+    std::vector<std::vector<std::pair<unsigned int, unsigned int>>> band_pairs(
+        nb_bands);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int b = 0; b < nb_bands; ++b)
+    {
+        std::unordered_map<std::uint64_t, std::vector<unsigned int>> buckets;
+        for (long long i = 0; i < n; ++i)
+        {
+            if (clusters[i].empty())
+            {
+                continue;
+            }
+            std::uint64_t key = b;
+            for (unsigned int j = b * r; j < (b + 1) * r; ++j)
+            {
+                key = mix(key ^ sketches[i][j]);
+            }
+            buckets[key].push_back(static_cast<unsigned int>(i));
+        }
+        // a bucket of m clusters yields O(m) pairs (not all m^2 pairs): each
+        // cluster is paired with the largest one and with the previous one in
+        // decreasing size order, which are the clusters the greedy selection
+        // keeps first
+        for (auto &bucket : buckets)
+        {
+            auto &members = bucket.second;
+            std::sort(members.begin(), members.end(),
+                [&](const unsigned int i, const unsigned int j)
+                {
+                    return clusters[i].size() != clusters[j].size() ?
+                        clusters[i].size() > clusters[j].size() : i < j;
+                });
+            for (std::size_t x = 1; x < members.size(); ++x)
+            {
+                band_pairs[b].push_back(std::minmax(members.front(),
+                    members[x]));
+                if (x > 1)
+                {
+                    band_pairs[b].push_back(std::minmax(members[x - 1],
+                        members[x]));
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<unsigned int, unsigned int>> candidates;
+    for (auto &pairs : band_pairs)
+    {
+        candidates.insert(candidates.end(), pairs.begin(), pairs.end());
+        std::vector<std::pair<unsigned int, unsigned int>>().swap(pairs);
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()),
+        candidates.end());
+
+    // verification by the exact Jaccard similarity
+    const long long nb_candidates = static_cast<long long>(candidates.size());
+    std::vector<char> similar(candidates.size(), false);
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (long long p = 0; p < nb_candidates; ++p)
+    {
+        similar[p] = jaccard(clusters[candidates[p].first],
+            clusters[candidates[p].second]) >= threshold;
+    }
+
+    std::vector<std::vector<unsigned int>> similar_clsts(clusters.size());
+    for (long long p = 0; p < nb_candidates; ++p)
+    {
+        if (similar[p])
+        {
+            similar_clsts[candidates[p].first].push_back(
+                candidates[p].second);
+            similar_clsts[candidates[p].second].push_back(
+                candidates[p].first);
+        }
+    }
+
+    // greedy selection: larger clusters are kept first
+    std::vector<unsigned int> order(clusters.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&](const unsigned int i, const unsigned int j)
+        {
+            return clusters[i].size() > clusters[j].size();
+        });
+
+    std::vector<bool> kept(clusters.size(), false);
+    std::vector<bool> dropped(clusters.size(), false);
+    for (auto i : order)
+    {
+        dropped[i] = std::any_of(similar_clsts[i].begin(),
+            similar_clsts[i].end(), [&](const unsigned int j)
+            {
+                return kept[j];
+            });
+        kept[i] = !dropped[i];
+    }
+
+    return dropped;
+}
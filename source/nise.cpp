@@ -12,16 +12,29 @@
 
 
 #include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
 #include <queue>
 #include <iostream>
 #include <forward_list>
 #include <fstream>
+#include <memory>
 #include <numeric>
+#include <omp.h>
 #include <sys/resource.h>
-#include <set>
+#include <sstream>
+#include <stdexcept>
 #include <thread>
 #include "../headers/nise.hpp"
+#include "../headers/checkpoint.hpp"
+#include "../headers/graclus.hpp"
 #include "../headers/graph_algorithms.hpp"
+#include "../headers/minhash.hpp"
+#include "../headers/ppr.hpp"
+#include "../headers/sweep.hpp"
+#include "../headers/time_mgmt.hpp"
+#include "../headers/trace.hpp"
 
 
 /////////////////////////////// Helper functions ///////////////////////////////
@@ -35,99 +48,26 @@ namespace
 const unsigned int graph_size_threshold = 50000; // magic number
 
 /**
- * @brief
+ * @brief Capacity of the streamed clusters queue and idle time of the writer
+ * thread when the queue is empty (streaming mode).
 */
-double conductance(const unsigned int g_nb_edges, 
-    const unsigned int vol, const unsigned int boundary_edges)
-{
-    assert(vol <= 2 * g_nb_edges);
-
-    unsigned int compl_vol = 2 * g_nb_edges - vol;
-    // prevent division by 0 see LNCS 3418 - Network Analysis
-    if (compl_vol == 0 || vol == 0)
-    {
-        return 1;
-    }
-
-    return static_cast<double>(boundary_edges) / std::min(vol, compl_vol);
-}
+const std::size_t stream_queue_capacity = 1024; // magic number
+const std::chrono::microseconds writer_idle_time(200); // magic number
 
 /**
-* @brief (see [1,3]).
-* @param const unsigned int: vertex index to add in queue.
-* @param std::queue<unsigned int> &: queue that holds vertices indices.
-* @param std::set<unsigned int> &: auxiliary data structure to track uniqueness.
+ * @brief The per-thread buffer of the seeds statistics is appended to the log
+ * file when its size reaches this value (in bytes).
 */
-void add_in_epsilon_approx_queue(const unsigned int v, 
-    std::queue<unsigned int> &q, std::set<unsigned int> &s)
-{
-    if (s.find(v) == s.end())
-    {
-        q.push(v);
-        s.insert(v);
-    }
-}
+const std::size_t stats_buffer_size = 1 << 20; // magic number
 
 /**
-* @brief Given a set of vertices sorted in the deacreasing 
-* probability-per-degree order this method selects a set of vertices of minimum
-* conductance (see [1,3]). This method is also known as degree-normalized
-* version of the sweep technique [3].
-* @param const Graph&: original graph.
-* @param const Graph&: biconnected core graph.
-* @param const std::vector<unsigned int>&: vertices indices of the original 
-* graph that belong to the biconnected core.
-* @param const std::vector<unsigned int>&: graph vertices indices sorted by 
-* probability-per-degree order.
-* @return Cluster: set (cluster) of vertices with the minimum conductance 
-* value. As described in [3] this cluster is formed by the first p vertices 
-* in the "vertices_sppd" that, together, compose a cluster with minimum 
-* conductance. In other words, the sweep set with minimum conductance.
+ * @brief Thread indices of the trace (flag "-t"). The ith seed expansion
+ * thread has index first_expansion_tid + i.
 */
-Cluster clst_min_conductance(
-    const Graph &original_g, 
-    const Graph &bcore_g,
-    const std::vector<unsigned int> &bcore_v,
-    const std::vector<unsigned int> &vertices_sppd)
-{
-    Cluster clst(original_g); // cluster constructed from original graph
-    std::set<unsigned int> sweep_set;
-    unsigned int vol = 0;
-    unsigned int boundary_edges = 0;
-    double min_cond = std::numeric_limits<double>::infinity();
-    for (unsigned int i = 0; i < vertices_sppd.size(); ++i)
-    {
-        // compute the number of boundary edges
-        sweep_set.insert(bcore_v[vertices_sppd[i]]); // insert original v label
-        auto adj_list = bcore_g.adj_list_of_vtx(vertices_sppd[i]);
-        for (auto it_adj = adj_list.first; it_adj != adj_list.second; ++it_adj)
-        {
-            if (sweep_set.find(bcore_v[*it_adj]) != sweep_set.end())
-            {
-                --boundary_edges;
-            }
-            else
-            {
-                ++boundary_edges;
-            }
-        }
-        vol += bcore_g.get_vtx_degree(vertices_sppd[i]);
-        // compute conductances
-        double cond = conductance(bcore_g.get_nb_edges(), vol, boundary_edges);
-        if (cond <= min_cond)
-        {
-            min_cond = cond;
-            // save set of vertices (clst) of minimum conductance
-            for (unsigned int j = clst.size(); j <= i; ++j)
-            {
-                // insert vertices from the original graph
-                clst.insert(bcore_v[vertices_sppd[j]]);
-            }
-        }
-    }
-
-    return clst;
-}
+const unsigned int main_tid = 0;
+const unsigned int seeding_tid = 1;
+const unsigned int writer_tid = 2;
+const unsigned int first_expansion_tid = 3;
 
 /**
 * @brief (see [1]).
@@ -157,7 +97,6 @@ Graph generate_biconnected_core_graph(
     const std::vector<unsigned int> &bcore_vertices, 
     const std::vector<bool> &contained_in_bcore)
 {
-    std::cout << "\t\t\tgenerating biconnected core...\n";
     // mapping the vertex label in the original graph to label in the new graph
     std::unordered_map<unsigned int, unsigned int> bcore_map;
     for (unsigned int i = 0; i < bcore_vertices.size(); ++i)
@@ -184,8 +123,9 @@ Graph generate_biconnected_core_graph(
 
 /**
 * @brief not my code.
+* @param const bool: whether the change is printed.
 */
-void increase_stack_size()
+void increase_stack_size(const bool verbose)
 {
     const rlim_t k_stack_size = 32 * 1024 * 1024; // min stack size = 16 MB
     struct rlimit rl;
@@ -195,10 +135,13 @@ void increase_stack_size()
     {
         if (rl.rlim_cur < k_stack_size)
         {
-            std::cout << "Changing stack size...\n";
+            if (verbose)
+            {
+                std::cout << "Changing stack size...\n";
+            }
             rl.rlim_cur = k_stack_size;
             result = setrlimit(RLIMIT_STACK, &rl);
-            if (result != 0)
+            if (result != 0 && verbose)
             {
                 std::cout << "setrlimit returned result = " << result << "\n";
             }
@@ -282,28 +225,50 @@ void mark_vertex_neighborhood(const unsigned int v, const Graph &bcore_g,
 
 
 /**
-* @brief Sort vertices indices in decreasing probability-per-degree (PPD) order. 
-* This fuction returns a vector of vertices indices sorted in decreasing 
-* probability-per-degree. See [1,3] for details.
-* @param:.
-* @param:.
+* @brief Get the output file path of a configuration in the parameter-sweep
+* mode: the configuration is appended to the file name (before the extension).
+* @param const std::string &: output file path.
+* @param const Nise_parameters::configuration &: configuration.
+* @return std::string: configuration output file path.
 */
-std::vector<unsigned int> sort_vertices_in_decreasing_ppd(
-    const std::unordered_map<unsigned int, double> &x, const Graph &bcore_g)
+std::string config_path(const std::string &path,
+    const Nise_parameters::configuration &config)
 {
-    std::vector<unsigned int> decreasing_ppd(x.size()); // vertices indices
-    unsigned int i = 0;
-    for (auto &e : x) // populate vector with vertices indices
+    const std::size_t name_pos = path.find_last_of('/') + 1;
+    std::size_t ext_pos = path.find_last_of('.');
+    if (ext_pos == std::string::npos || ext_pos <= name_pos)
     {
-        decreasing_ppd[i++] = e.first;
+        ext_pos = path.size();
     }
-    std::sort(decreasing_ppd.begin(), decreasing_ppd.end(), // sort
-        [&](const unsigned int v1, const unsigned int v2)
+    std::ostringstream config_path;
+    config_path << path.substr(0, ext_pos) << "_a" << config.alpha << "_e" <<
+        config.epsilon << "_s" << config.nb_seeds << path.substr(ext_pos);
+    return config_path.str();
+}
+
+/**
+* @brief Format a cluster as a line of the clustering file (see
+* Clustering::write_clusters_in_file).
+* @param const std::vector<unsigned int> &: cluster vertices.
+* @return std::string: line (with the newline).
+*/
+std::string format_clst_line(const std::vector<unsigned int> &vertices)
+{
+    // at most 10 digits and a separator per vertex and the newline
+    std::string line(11 * vertices.size() + 1, ' ');
+    char *out = &line[0];
+    char *const end = out + line.size();
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+    {
+        out = std::to_chars(out, end, vertices[i]).ptr;
+        if (i + 1 < vertices.size())
         {
-            return (x.at(v1) / static_cast<double>(bcore_g.get_vtx_degree(v1))) 
-                > (x.at(v2) / static_cast<double>(bcore_g.get_vtx_degree(v2)));
-        });
-    return decreasing_ppd;
+            *out++ = ' ';
+        }
+    }
+    *out++ = '\n';
+    line.resize(out - &line[0]);
+    return line;
 }
 
 } // anonymous namespace
@@ -314,47 +279,264 @@ std::vector<unsigned int> sort_vertices_in_decreasing_ppd(
 Nise::Nise(const Graph &g, const Nise_parameters &p) :
     m_graph(g),
     m_p(p),
-    m_clusters(g.get_nb_vertices())
+    m_configs(p.get_configurations()),
+    m_nb_seeds(0)
 {
+    if (!m_p.get_trace_path().empty())
+    {
+        m_trace = std::make_unique<Trace>();
+        m_trace->set_thread_name(main_tid, "main");
+    }
+
+    init_configurations();
+
     if (m_graph.get_nb_vertices() > graph_size_threshold)
     {
-        increase_stack_size();
+        increase_stack_size(m_p.verbose());
     }
 }
 
 
+Nise::Nise(const Graph &g, const unsigned int nb_seeds, const double alpha,
+    const double epsilon) :
+    Nise(g, Nise_parameters({alpha, epsilon, nb_seeds}))
+{
+}
+
+
 void Nise::execute()
 {
-    // utils::time_mgmt tmgmt;
-    // tmgmt.start();
-    
-    // filtering phase: find the biconnected core (bcore)
-    std::vector<unsigned int> bcore_v; // vertices belonging in bcore
-    std::vector<bool> contained_in_bcore; // flag vector of original graph
-    std::vector<Graph::edge> bridges; // bridges edges.
+    if (m_executed)
+    {
+        reset_run();
+    }
+    m_deadline = m_time_limit > 0 ? std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(m_time_limit)) :
+        std::chrono::steady_clock::time_point::max();
+
+    // the number of threads of the caller is restored before returning
+    const int caller_nb_threads = omp_get_max_threads();
+    omp_set_num_threads(static_cast<int>(m_p.nb_threads()));
+    utils::time_mgmt tmgmt;
+    tmgmt.start();
+    utils::time_mgmt phase_tmgmt; // timer of each phase (see m_report)
+    phase_tmgmt.start();
+    if (m_p.profiling())
+    {
+        if (!m_phase_counters.open(true) && m_p.verbose())
+        {
+            std::cout << "[WARNING] Nise::execute: the performance counters "
+                "are not available.\n";
+        }
+        m_phase_counters.start();
+    }
 
-    std::tie(bcore_v, contained_in_bcore, bridges) = filtering_phase(m_graph);
+    // filtering phase: find the biconnected core (bcore). Its output is kept
+    // by the next executions
+    std::vector<unsigned int> done_seeds; // seeds expanded by a previous run
+    build_bcore(phase_tmgmt, done_seeds);
+    const Graph &bcore_g = *m_bcore_g;
+    const std::vector<unsigned int> &bcore_v = m_bcore_v;
+    const std::vector<Graph::edge> &bridges = m_bridges;
+
+    // clusters with smaller ids were loaded from a checkpoint
+    const unsigned int first_new_clst_id = m_clusterings.front().size();
+
+    // streaming mode: the clusters are propagated by the whisker mapping and
+    // written by the writer thread as soon as they are expanded
+    std::vector<std::ofstream> stream_files;
+    std::thread writer_thread;
+    if (m_p.streaming())
+    {
+        for (auto &whisker : find_whiskers(bridges, m_contained_in_bcore))
+        {
+            auto &mapped = m_whisker_map[whisker.first];
+            mapped.insert(mapped.end(), whisker.second.begin(),
+                whisker.second.end());
+        }
+        for (const auto &c : m_configs)
+        {
+            const std::string path = m_configs.size() > 1 ?
+                config_path(m_p.get_output_path(), c) : m_p.get_output_path();
+            stream_files.emplace_back(path, std::ios::binary |
+                std::fstream::trunc);
+            if (!stream_files.back())
+            {
+                std::cerr << "[ERROR] Nise::execute: it was not possible to "
+                    "open " << path << ".\n";
+                exit(EXIT_FAILURE);
+            }
+        }
+        m_stream_q = std::make_unique<Lock_free_queue<streamed_clst>>(
+            stream_queue_capacity);
+        writer_thread = std::thread(&Nise::clusters_writer_thread_task, this,
+            std::ref(stream_files));
+    }
 
-    // generate new a graph from vertices belonging in the biconnected core
-    Graph bcore_g = 
-        generate_biconnected_core_graph(m_graph, bcore_v, contained_in_bcore);
+    // the seeding and seed expansion phases are pipelined (their times
+    // overlap in the report)
+    Concurrent_queue<seed_entry> seeds_q;
+    std::vector<unsigned int> seeds;
+    utils::time_mgmt seeding_tmgmt;
+    Run_report::counters seeding_counters;
+    std::thread seeding_thread([&]()
+        {
+            Trace::Thread_buffer trace_buffer(m_trace.get(), seeding_tid,
+                "seeding");
+            Perf_counters counters;
+            if (m_p.profiling() && counters.open(false))
+            {
+                counters.start();
+            }
+            seeding_tmgmt.start();
+            seeds = seeding_phase(bcore_g, seeds_q);
+            seeding_tmgmt.end();
+            counters.stop();
+            seeding_counters = counters.get_values();
+            trace_buffer.add("seeding", "phase",
+                seeding_tmgmt.get_start_time(), seeding_tmgmt.get_end_time());
+        });
 
-    auto seeds = seeding_phase(bcore_g);
+    seed_expansion_phase(bcore_g, bcore_v, seeds_q);
+    seeding_thread.join();
+    m_report.add_phase("seeding", seeding_tmgmt, seeding_counters);
 
-    seed_expansion_phase(bcore_g, bcore_v, seeds);
+    if (m_p.streaming())
+    {
+        m_stream_q->close();
+        writer_thread.join();
+        m_stream_q.reset();
+        for (auto &f : stream_files)
+        {
+            f.close();
+            if (!f)
+            {
+                std::cerr << "[ERROR] Nise::execute: it was not possible to "
+                    "write the streamed clusters.\n";
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+    add_phase_to_report("expansion", phase_tmgmt);
+
+    if (m_p.streaming())
+    {
+        tmgmt.end();
+        m_execution_time = tmgmt.get_total_time_in_sec();
+        m_executed = true;
+        omp_set_num_threads(caller_nb_threads);
+        return;
+    }
+
+    if (m_p.jaccard_threshold() > 0)
+    {
+        remove_near_duplicates();
+        add_phase_to_report("near_duplicates_removal", phase_tmgmt);
+    }
+
+    // the expanded clusters are indexed in a single parallel step
+    for (unsigned int i = 0; i < m_clusterings.size(); ++i)
+    {
+        m_clusterings[i].insert(std::move(m_expanded_clsts[i]));
+    }
+    add_phase_to_report("indexing", phase_tmgmt);
 
-    propagation_phase(bridges, contained_in_bcore);
+    if (m_p.verbose() && (done_seeds.size() > seeds.size() ||
+        !std::equal(done_seeds.begin(), done_seeds.end(), seeds.begin())))
+    {
+        std::cout << "[WARNING] Nise::execute: the checkpoint seeds are not a "
+            "prefix of the current seeds.\n";
+    }
+
+    // propagation phase changes the flags
+    std::vector<bool> contained_in_bcore = m_contained_in_bcore;
+    propagation_phase(bridges, contained_in_bcore, first_new_clst_id);
+    add_phase_to_report("propagation", phase_tmgmt);
+
+    if (!m_p.get_checkpoint_path().empty())
+    {
+        write_checkpoint(m_contained_in_bcore, bridges, seeds);
+        add_phase_to_report("checkpoint", phase_tmgmt);
+    }
 
-    // tmgmt.end();
-    // m_execution_time = tmgmt.get_total_time_in_sec();
+    tmgmt.end();
+    m_execution_time = tmgmt.get_total_time_in_sec();
 
     m_executed = true;
+    omp_set_num_threads(caller_nb_threads);
+}
+
+
+void Nise::execute(const unsigned int nb_seeds, const double alpha,
+    const double epsilon)
+{
+    if (!m_p.set_configuration({alpha, epsilon, nb_seeds}))
+    {
+        throw std::invalid_argument("Nise::execute: invalid configuration");
+    }
+    m_configs = m_p.get_configurations();
+    reset_run();
+    execute();
+}
+
+
+void Nise::execute(const std::vector<unsigned int> &seeds, const double alpha,
+    const double epsilon)
+{
+    if (!Nise_parameters::is_valid(alpha, epsilon))
+    {
+        throw std::invalid_argument("Nise::execute: invalid configuration");
+    }
+    prepare();
+
+    // the seeds are mapped to the biconnected core vertices (see [1])
+    m_seeds.clear();
+    std::unordered_set<unsigned int> given;
+    for (const auto v : seeds)
+    {
+        if (v < m_contained_in_bcore.size() && m_contained_in_bcore[v] &&
+            given.insert(v).second)
+        {
+            m_seeds.push_back(static_cast<unsigned int>(std::lower_bound(
+                m_bcore_v.begin(), m_bcore_v.end(), v) - m_bcore_v.begin()));
+        }
+    }
+
+    m_given_seeds = true;
+    execute(std::max(1u, static_cast<unsigned int>(m_seeds.size())), alpha,
+        epsilon);
+    m_given_seeds = false;
+}
+
+
+void Nise::prepare()
+{
+    utils::time_mgmt phase_tmgmt;
+    phase_tmgmt.start();
+    std::vector<unsigned int> done_seeds;
+    build_bcore(phase_tmgmt, done_seeds);
+}
+
+
+void Nise::set_time_limit(const double seconds)
+{
+    m_time_limit = seconds;
+}
+
+
+bool Nise::timed_out() const
+{
+    return m_timed_out;
 }
 
 
 void Nise::write_clustering() const
 {
-    std::cout << "Writing clustering in file...\n";
+    if (m_p.verbose())
+    {
+        std::cout << "Writing clustering in file...\n";
+    }
     if (!m_executed)
     {
         std::cerr << "LECM algorithm hasn't been executed! I can't write any "
@@ -362,17 +544,251 @@ void Nise::write_clustering() const
         exit(EXIT_FAILURE);
     }
 
-    m_clusters.write_clusters_in_file("./clustering.dat");
+    if (m_p.streaming())
+    {
+        return; // already written by the writer thread
+    }
+
+    utils::time_mgmt tmgmt;
+    tmgmt.start();
+    m_phase_counters.start();
+    const std::string output_path = m_p.get_output_path();
+    const std::string binary_path = m_p.get_binary_output_path();
+    for (unsigned int i = 0; i < m_configs.size(); ++i)
+    {
+        const bool sweep = m_configs.size() > 1;
+        auto start = Trace::clock::now();
+        const std::string path = sweep ?
+            config_path(output_path, m_configs[i]) : output_path;
+        m_clusterings[i].write_clusters_in_file(path);
+        if (m_trace)
+        {
+            m_trace->add("write " + path, "io", start, Trace::clock::now(),
+                main_tid);
+        }
+        if (!binary_path.empty())
+        {
+            start = Trace::clock::now();
+            const std::string bin_path = sweep ?
+                config_path(binary_path, m_configs[i]) : binary_path;
+            m_clusterings[i].write_clusters_in_binary_file(bin_path);
+            if (m_trace)
+            {
+                m_trace->add("write " + bin_path, "io", start,
+                    Trace::clock::now(), main_tid);
+            }
+        }
+    }
+    add_phase_to_report("writing", tmgmt);
+}
+
+
+void Nise::write_trace() const
+{
+    if (m_trace && !m_trace->write(m_p.get_trace_path()))
+    {
+        std::cerr << "[ERROR] Nise::write_trace: it was not possible to "
+            "write " << m_p.get_trace_path() << ".\n";
+    }
+}
+
+
+void Nise::report_phase(const std::string &name, const utils::time_mgmt &tmgmt)
+{
+    m_report.add_phase(name, tmgmt);
+    if (m_trace)
+    {
+        m_trace->add(name, "phase", tmgmt.get_start_time(),
+            tmgmt.get_end_time(), main_tid);
+    }
+}
+
+
+void Nise::write_report() const
+{
+    m_report.set_field("graph", Run_report::quote(m_p.get_graph_path()));
+    m_report.set_field("nb_vertices",
+        std::to_string(m_graph.get_nb_vertices()));
+    m_report.set_field("nb_edges", std::to_string(m_graph.get_nb_edges()));
+    m_report.set_field("nb_threads", std::to_string(m_p.nb_threads()));
+    m_report.set_field("seeding_method", Run_report::quote(
+        m_p.get_seeding_method() ==
+        Nise_parameters::seeding_method::spread_hubs ? "sph" : "graclus"));
+
+    std::ostringstream configs;
+    configs << "[";
+    for (unsigned int i = 0; i < m_configs.size(); ++i)
+    {
+        configs << (i == 0 ? "" : ", ") << "{\"alpha\": " <<
+            m_configs[i].alpha << ", \"epsilon\": " << m_configs[i].epsilon <<
+            ", \"nb_seeds\": " << m_configs[i].nb_seeds << ", \"nb_clusters\": "
+            << (m_p.streaming() ? m_nb_streamed[i] : m_clusterings[i].size())
+            << "}";
+    }
+    configs << "]";
+    m_report.set_field("configurations", configs.str());
+    m_report.set_field("execution_time_sec", std::to_string(m_execution_time));
+    m_report.set_field("nb_expansions", std::to_string(m_nb_expansions.load()));
+    m_report.set_field("nb_pushes", std::to_string(m_nb_pushes.load()));
+    if (m_p.profiling())
+    {
+        std::string threads = "[";
+        for (std::size_t i = 0; i < m_thread_counters.size(); ++i)
+        {
+            threads += (i == 0 ? "" : ", ") +
+                Run_report::to_json(m_thread_counters[i]);
+        }
+        m_report.set_field("expansion_threads_counters", threads + "]");
+    }
+
+    const std::string path = m_p.get_output_path() + ".report.json";
+    if (!m_report.write(path))
+    {
+        std::cerr << "[ERROR] Nise::write_report: it was not possible to "
+            "write " << path << ".\n";
+    }
+}
+
+
+Run_report& Nise::get_report()
+{
+    return m_report;
+}
+
+
+const std::vector<Clustering>& Nise::get_clusterings() const
+{
+    return m_clusterings;
+}
+
+
+const std::vector<Nise_parameters::configuration>&
+    Nise::get_configurations() const
+{
+    return m_configs;
+}
+
+
+unsigned long long Nise::get_nb_expansions() const
+{
+    return m_nb_expansions;
+}
+
+
+unsigned long long Nise::get_nb_pushes() const
+{
+    return m_nb_pushes;
 }
 
 
 /////////////////////////////// private methods ////////////////////////////////
 
 
+void Nise::build_bcore(utils::time_mgmt &phase_tmgmt,
+    std::vector<unsigned int> &done_seeds)
+{
+    if (m_bcore_g)
+    {
+        return;
+    }
+
+    const bool resumed =
+        resume_from_checkpoint(m_contained_in_bcore, m_bridges, done_seeds);
+    if (resumed)
+    {
+        // the biconnected core vertices are in increasing order (see [1])
+        for (unsigned int v = 0; v < m_contained_in_bcore.size(); ++v)
+        {
+            if (m_contained_in_bcore[v])
+            {
+                m_bcore_v.push_back(v);
+            }
+        }
+    }
+    else
+    {
+        std::tie(m_bcore_v, m_contained_in_bcore, m_bridges) =
+            filtering_phase(m_graph);
+    }
+    add_phase_to_report(resumed ? "checkpoint_loading" : "filtering",
+        phase_tmgmt);
+
+    // generate new a graph from vertices belonging in the biconnected core
+    if (m_p.verbose())
+    {
+        std::cout << "\t\t\tgenerating biconnected core...\n";
+    }
+    m_bcore_g = std::make_unique<Graph>(generate_biconnected_core_graph(
+        m_graph, m_bcore_v, m_contained_in_bcore));
+    add_phase_to_report("core_graph", phase_tmgmt);
+}
+
+
+void Nise::init_configurations()
+{
+    m_nb_seeds = 0;
+    m_clusterings.clear();
+    for (const auto &c : m_configs)
+    {
+        m_nb_seeds = std::max(m_nb_seeds, c.nb_seeds);
+        m_clusterings.emplace_back(m_graph.get_nb_vertices());
+    }
+    m_expanded_clsts.clear();
+    m_expanded_clsts.resize(m_configs.size());
+    m_expanded_fps.clear();
+    m_expanded_fps.resize(m_configs.size());
+    m_nb_streamed.assign(m_configs.size(), 0);
+
+    m_config_order.resize(m_configs.size());
+    std::iota(m_config_order.begin(), m_config_order.end(), 0);
+    std::sort(m_config_order.begin(), m_config_order.end(),
+        [&](const unsigned int i, const unsigned int j)
+        {
+            return m_configs[i].alpha != m_configs[j].alpha ?
+                m_configs[i].alpha < m_configs[j].alpha :
+                m_configs[i].epsilon > m_configs[j].epsilon;
+        });
+}
+
+
+void Nise::reset_run()
+{
+    init_configurations();
+    m_done_seeds.clear();
+    m_whisker_map.clear();
+    m_thread_counters.clear();
+    m_nb_expansions = 0;
+    m_nb_pushes = 0;
+    m_report = Run_report();
+    m_execution_time = 0;
+    m_timed_out = false;
+    m_executed = false;
+}
+
+
+void Nise::add_phase_to_report(const std::string &name,
+    utils::time_mgmt &tmgmt) const
+{
+    tmgmt.end();
+    m_phase_counters.stop();
+    m_report.add_phase(name, tmgmt, m_phase_counters.get_values());
+    if (m_trace)
+    {
+        m_trace->add(name, "phase", tmgmt.get_start_time(),
+            tmgmt.get_end_time(), main_tid);
+    }
+    m_phase_counters.start();
+    tmgmt.start();
+}
+
+
 std::tuple<std::vector<unsigned int>, std::vector<bool>, 
     std::vector<Graph::edge>> Nise::filtering_phase(Graph g)
 {
-    std::cout << "\t\tfiltering phase...\n";
+    if (m_p.verbose())
+    {
+        std::cout << "\t\tfiltering phase...\n";
+    }
 
     // get all biconnected components of the original graph
     auto bcs = utils::graph_algorithms::biconnected_components(g);
@@ -419,150 +835,439 @@ std::tuple<std::vector<unsigned int>, std::vector<bool>,
 
 
 void Nise::propagation_phase(const std::vector<Graph::edge> &bridges,
-    std::vector<bool> &contained_in_bcore)
+    std::vector<bool> &contained_in_bcore, const unsigned int first_clst_id)
 {
-    std::cout << "\t\tpropagation phase...\n";
-    for (auto &e : bridges)
+    if (m_p.verbose())
     {
-        // biconnected core vertex
-        unsigned int bcv = contained_in_bcore[e.first] ? e.first : e.second;
-        // starting whisker vertex
-        unsigned int swv = contained_in_bcore[e.first] ? e.second : e.first;
-        // breadth-first-search from swv
-        std::queue<unsigned int> q;
-        q.push(swv);
-        while (!q.empty())
+        std::cout << "\t\tpropagation phase...\n";
+    }
+
+    auto whiskers = find_whiskers(bridges, contained_in_bcore);
+    for (const auto &whisker : whiskers)
+    {
+        for (auto v : whisker.second)
         {
-            swv = q.front();
-            q.pop();
+            contained_in_bcore[v] = true;
+        }
+    }
 
-            // insert swv in all clusters that bcv belongs to
-            auto clsts_id = m_clusters.get_v_belonging(bcv);
+    // each whisker tree is inserted in all clusters that its bcore vertex
+    // belongs to, in a single batch per clustering
+    for (auto &clusters : m_clusterings)
+    {
+        std::unordered_map<unsigned int, std::vector<unsigned int>> batches;
+        for (const auto &whisker : whiskers)
+        {
+            auto clsts_id = clusters.get_v_belonging(whisker.first);
             for (auto it = clsts_id.first; it != clsts_id.second; ++it)
             {
-                m_clusters.insert_v_in_clst(swv, *it);
+                if (*it >= first_clst_id) // older clusters already have them
+                {
+                    auto &batch = batches[*it];
+                    batch.insert(batch.end(), whisker.second.begin(),
+                        whisker.second.end());
+                }
             }
+        }
+        clusters.insert_vs_in_clsts(std::vector<std::pair<unsigned int, 
+            std::vector<unsigned int>>>(
+                std::make_move_iterator(batches.begin()),
+                std::make_move_iterator(batches.end())));
+    }
+}
+
 
-            auto adj_list = m_graph.adj_list_of_vtx(swv);
+std::vector<std::pair<unsigned int, std::vector<unsigned int>>>
+    Nise::find_whiskers(const std::vector<Graph::edge> &bridges,
+    const std::vector<bool> &contained_in_bcore) const
+{
+    /* whiskers of different bridges are disjoint (otherwise the bridges would
+    be in a cycle), so their trees are collected in parallel. Bytes flags are
+    used because concurrent writes to std::vector<bool> bits are not safe */
+    const long long nb_bridges = static_cast<long long>(bridges.size());
+    std::vector<unsigned char> visited(contained_in_bcore.begin(),
+        contained_in_bcore.end());
+    std::vector<std::pair<unsigned int, std::vector<unsigned int>>> whiskers(
+        bridges.size());
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (long long i = 0; i < nb_bridges; ++i)
+    {
+        const Graph::edge &e = bridges[i];
+        // biconnected core vertex
+        whiskers[i].first = contained_in_bcore[e.first] ? e.first : e.second;
+        // starting whisker vertex
+        unsigned int swv = contained_in_bcore[e.first] ? e.second : e.first;
+        // breadth-first-search from swv
+        std::vector<unsigned int> &tree = whiskers[i].second;
+        tree.push_back(swv);
+        visited[swv] = true;
+        for (std::size_t j = 0; j < tree.size(); ++j)
+        {
+            auto adj_list = m_graph.adj_list_of_vtx(tree[j]);
             for (auto it = adj_list.first; it != adj_list.second; ++it)
             {
-                if (!contained_in_bcore[*it])
+                if (!visited[*it])
                 {
-                    q.push(*it);
-                    contained_in_bcore[*it] = true;
+                    tree.push_back(*it);
+                    visited[*it] = true;
                 }
             }
         }
     }
+
+    return whiskers;
 }
 
 
-Cluster Nise::seed_expansion_by_ppr(
-    const Graph &bcore_g,
-    const std::vector<unsigned int> &bcore_v,
-    const unsigned int seed)
+void Nise::clusters_writer_thread_task(std::vector<std::ofstream> &files)
 {
-    std::unordered_map<unsigned int, double> x;
-    std::unordered_map<unsigned int, double> r;
-
-    // initialize x and r of vertex seed and its neighboors
-    x[seed] = 0;
-    r[seed] = 1.0 / static_cast<double>(bcore_g.get_vtx_degree(seed) + 1);
-    auto adj_list = bcore_g.adj_list_of_vtx(seed);
-    for (auto it = adj_list.first; it != adj_list.second; ++it)
+    Trace::Thread_buffer trace_buffer(m_trace.get(), writer_tid, "writer");
+    Trace::clock::time_point burst_start; // first write after an idle time
+    streamed_clst clst;
+    bool unflushed = false;
+    while (true)
     {
-        x[*it] = 0;
-        r[*it] = 1.0 / static_cast<double>(bcore_g.get_vtx_degree(seed) + 1);
-    }
+        if (m_stream_q->try_pop(clst))
+        {
+            if (!unflushed && trace_buffer.enabled())
+            {
+                burst_start = Trace::clock::now();
+            }
+            files[clst.config_id].write(clst.line.data(), clst.line.size());
+            ++m_nb_streamed[clst.config_id];
+            unflushed = true;
+            continue;
+        }
 
-    // queue of vertices used in next loop as presented by [3]
-    std::queue<unsigned int> q;
-    std::set<unsigned int> s; // auxiliary data structure to track uniqueness
-    for (auto it = r.begin(); it != r.end(); ++it)
-    {
-        if ((*it).second > bcore_g.get_vtx_degree((*it).first) * m_p.epsilon())
+        if (unflushed) // the queue is empty: make the partial results visible
         {
-            add_in_epsilon_approx_queue((*it).first, q, s);
+            for (auto &f : files)
+            {
+                f.flush();
+            }
+            unflushed = false;
+            if (trace_buffer.enabled())
+            {
+                trace_buffer.add("write clusters", "io", burst_start,
+                    Trace::clock::now());
+            }
         }
-    }
 
-    // compute and update x and r values
-    while (!q.empty()) // while there is a v such that r[v] > deg(v) * epsilon
-    {
-        unsigned int v = q.front();
-        x[v] += (1 - m_p.alpha()) * r[v];
-        adj_list = bcore_g.adj_list_of_vtx(v);
-        for (auto it_u = adj_list.first; it_u != adj_list.second; ++it_u)
+        if (m_stream_q->is_closed()) // no more clusters will be pushed
         {
-            r[*it_u] += (m_p.alpha() * r[v]) / (2 * bcore_g.get_vtx_degree(v));
-            if (r[*it_u] > bcore_g.get_vtx_degree(*it_u) * m_p.epsilon())
+            while (m_stream_q->try_pop(clst))
             {
-                add_in_epsilon_approx_queue(*it_u, q, s);
+                files[clst.config_id].write(clst.line.data(),
+                    clst.line.size());
+                ++m_nb_streamed[clst.config_id];
             }
+            return;
         }
-        r[v] = m_p.alpha() * r[v] / 2;
-        if (r[v] <= bcore_g.get_vtx_degree(v) * m_p.epsilon())
+        std::this_thread::sleep_for(writer_idle_time);
+    }
+}
+
+
+void Nise::remove_near_duplicates()
+{
+    if (m_p.verbose())
+    {
+        std::cout << "\t\tnear-duplicates removal...\n";
+    }
+    for (auto &expanded : m_expanded_clsts)
+    {
+        auto dropped = utils::minhash::near_duplicates(expanded,
+            m_p.jaccard_threshold());
+        std::vector<Cluster> kept;
+        kept.reserve(expanded.size());
+        for (std::size_t i = 0; i < expanded.size(); ++i)
         {
-            q.pop();
+            if (!dropped[i])
+            {
+                kept.push_back(std::move(expanded[i]));
+            }
         }
+        expanded.clear();
+        expanded.swap(kept);
+    }
+}
+
+
+bool Nise::resume_from_checkpoint(std::vector<bool> &contained_in_bcore,
+    std::vector<Graph::edge> &bridges, std::vector<unsigned int> &done_seeds)
+{
+    Nise_checkpoint ckpt;
+    if (m_p.get_checkpoint_path().empty() ||
+        !ckpt.read(m_p.get_checkpoint_path()))
+    {
+        return false;
+    }
+
+    if (m_p.verbose())
+    {
+        std::cout << "\t\tresuming from checkpoint...\n";
+    }
+    if (ckpt.nb_vertices != m_graph.get_nb_vertices() ||
+        ckpt.nb_edges != m_graph.get_nb_edges())
+    {
+        std::cerr << "[ERROR] Nise::resume_from_checkpoint: the checkpoint "
+            "belongs to another graph. Aborting...\n";
+        exit(EXIT_FAILURE);
+    }
+    if (ckpt.alpha != m_p.alpha() || ckpt.epsilon != m_p.epsilon())
+    {
+        std::cerr << "[ERROR] Nise::resume_from_checkpoint: the checkpoint "
+            "was computed with other alpha and epsilon values. Aborting...\n";
+        exit(EXIT_FAILURE);
+    }
+    // only spread hubs seeds of a smaller run are a prefix of the new seeds
+    if (ckpt.seeding_method != Nise_parameters::seeding_method::spread_hubs ||
+        m_p.get_seeding_method() != Nise_parameters::seeding_method::spread_hubs)
+    {
+        std::cerr << "[ERROR] Nise::resume_from_checkpoint: only the spread "
+            "hubs seeding can be resumed. Aborting...\n";
+        exit(EXIT_FAILURE);
+    }
+
+    contained_in_bcore = std::move(ckpt.contained_in_bcore);
+    bridges = std::move(ckpt.bridges);
+    done_seeds = std::move(ckpt.seeds);
+    m_done_seeds.insert(done_seeds.begin(), done_seeds.end());
+
+    Clustering &clusters = m_clusterings.front(); // a single configuration
+    clusters.reserve(ckpt.clusters.size());
+    for (const auto &vertices : ckpt.clusters)
+    {
+        clusters.insert(Cluster(m_graph, vertices));
+    }
+
+    return true;
+}
+
+
+Cluster Nise::seed_expansion_by_ppr(
+    const Graph &bcore_g,
+    const std::vector<unsigned int> &bcore_v,
+    Ppr_vector &ppr,
+    const double epsilon,
+    expansion_stats *stats)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const unsigned long long nb_pushes = ppr.get_nb_pushes();
+
+    // compute (or refine) the approximate PPR vector (see [3])
+    if (!ppr.approximate(epsilon, m_deadline))
+    {
+        m_timed_out = true;
+        return Cluster(m_graph);
     }
 
     // sort vertices in decreasing probability-per-degree (PPD) order
-    auto decreasing_ppd = sort_vertices_in_decreasing_ppd(x, bcore_g);
+    auto decreasing_ppd = utils::sweep::sort_vertices_in_decreasing_ppd(
+        ppr.get_x(), bcore_g);
 
     // sweep step: pick and return the set (cluster) with minimum conductance
-    return clst_min_conductance(m_graph, bcore_g, bcore_v, decreasing_ppd);
+    double min_cond;
+    Cluster clst = utils::sweep::clst_min_conductance(m_graph, bcore_g,
+        bcore_v, decreasing_ppd, min_cond);
+
+    if (stats)
+    {
+        stats->nb_pushes = ppr.get_nb_pushes() - nb_pushes;
+        stats->nb_touched = ppr.get_nb_touched();
+        stats->support_size = std::count_if(ppr.get_x().begin(),
+            ppr.get_x().end(), [](const std::pair<unsigned int, double> &e)
+            {
+                return e.second > 0;
+            });
+        stats->sweep_prefix = clst.size();
+        stats->min_conductance = min_cond;
+        stats->time = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+    return clst;
 }
 
 
 void Nise::seed_expansion_phase(const Graph &bcore_g, 
     const std::vector<unsigned int> &bcore_v, 
-    const std::vector<unsigned int> &seeds)
+    Concurrent_queue<seed_entry> &seeds_q)
 {
-    std::cout << "\t\tseeding expansion phase...\n";
-    const unsigned int nb_threads = std::thread::hardware_concurrency();
+    if (m_p.verbose())
+    {
+        std::cout << "\t\tseeding expansion phase...\n";
+    }
+    const unsigned int nb_threads = m_p.nb_threads();
     std::vector<std::thread> threads;
     threads.reserve(nb_threads);
 
+    if (!m_p.get_stats_path().empty())
+    {
+        m_stats_file.open(m_p.get_stats_path(), std::fstream::trunc);
+        if (!m_stats_file)
+        {
+            std::cerr << "[ERROR] Nise::seed_expansion_phase: it was not "
+                "possible to open " << m_p.get_stats_path() << ".\n";
+            exit(EXIT_FAILURE);
+        }
+        m_stats_file << "seed,config,alpha,epsilon,nb_pushes,touched_vertices,"
+            "support_size,sweep_prefix,min_conductance,time_sec,thread\n";
+    }
+
+    m_thread_counters.assign(nb_threads, Run_report::counters());
     for (unsigned int i = 0; i < nb_threads; ++i)
     {
         threads.push_back(std::thread(&Nise::seed_expansion_thread_task, this,
-            std::ref(bcore_g), std::ref(bcore_v), std::ref(seeds), i));
+            std::ref(bcore_g), std::ref(bcore_v), std::ref(seeds_q), i));
     }
 
     for (auto &t : threads)
     {
         t.join();
     }
+
+    if (m_stats_file.is_open())
+    {
+        m_stats_file.close();
+        if (!m_stats_file)
+        {
+            std::cerr << "[ERROR] Nise::seed_expansion_phase: it was not "
+                "possible to write " << m_p.get_stats_path() << ".\n";
+            exit(EXIT_FAILURE);
+        }
+    }
 }
 
 
 void Nise::seed_expansion_thread_task(const Graph &bcore_g, 
     const std::vector<unsigned int> &bcore_v, 
-    const std::vector<unsigned int> &seeds,
+    Concurrent_queue<seed_entry> &seeds_q,
     const unsigned int thread_id)
 {
-    const unsigned int nb_threads = std::thread::hardware_concurrency();
-    const unsigned int thread_offset = seeds.size() / nb_threads;
-    const unsigned int rem = seeds.size() % nb_threads;
-    unsigned int starting_seed = thread_id * thread_offset; 
-    unsigned int final_seed = starting_seed + thread_offset;
+    // the seeds statistics are formatted in a buffer of this thread, which is
+    // appended to the log file only when it is full
+    const bool log_stats = m_stats_file.is_open();
+    std::string stats_buffer;
+    expansion_stats stats;
+    unsigned long long nb_expansions = 0;
+    unsigned long long nb_pushes = 0;
+    Trace::Thread_buffer trace_buffer(m_trace.get(),
+        first_expansion_tid + thread_id,
+        "expansion " + std::to_string(thread_id));
+    Perf_counters counters;
+    if (m_p.profiling() && counters.open(false))
+    {
+        counters.start();
+    }
+    seed_entry seed;
+    while (seeds_q.pop(seed))
+    {
+        if (m_done_seeds.find(seed.vtx) != m_done_seeds.end())
+        {
+            continue; // expanded by a previous run (see checkpoint)
+        }
+        if (m_timed_out)
+        {
+            continue; // the time limit was reached (see set_time_limit)
+        }
+        // configurations with the same alpha are visited in decreasing
+        // epsilon order, so with the warm start (flag "-r 1") the PPR vector
+        // of the seed is only refined
+        std::unique_ptr<Ppr_vector> ppr;
+        for (const unsigned int i : m_config_order)
+        {
+            if (seed.rank < m_configs[i].nb_seeds)
+            {
+                if (!ppr || ppr->get_alpha() != m_configs[i].alpha ||
+                    !m_p.warm_start())
+                {
+                    nb_pushes += ppr ? ppr->get_nb_pushes() : 0;
+                    ppr = std::make_unique<Ppr_vector>(bcore_g, seed.vtx,
+                        m_configs[i].alpha);
+                }
+                ++nb_expansions;
+                const auto start = Trace::clock::now();
+                Cluster clst = seed_expansion_by_ppr(bcore_g, bcore_v, *ppr,
+                    m_configs[i].epsilon, log_stats ? &stats : nullptr);
+                if (m_timed_out)
+                {
+                    break; // the remaining expansions are skipped
+                }
+                if (trace_buffer.enabled())
+                {
+                    trace_buffer.add("seed " + std::to_string(
+                        bcore_v[seed.vtx]), "expansion", start,
+                        Trace::clock::now(), "\"seed\": " + std::to_string(
+                        bcore_v[seed.vtx]) + ", \"config\": " +
+                        std::to_string(i) + ", \"size\": " +
+                        std::to_string(clst.size()));
+                }
+                shared_clst_insertion(std::move(clst), i, trace_buffer);
+                if (log_stats)
+                {
+                    char line[256];
+                    const int size = std::snprintf(line, sizeof(line),
+                        "%u,%u,%.9g,%.9g,%llu,%zu,%zu,%zu,%.9g,%.9g,%u\n",
+                        bcore_v[seed.vtx], i, m_configs[i].alpha,
+                        m_configs[i].epsilon, stats.nb_pushes,
+                        stats.nb_touched, stats.support_size,
+                        stats.sweep_prefix, stats.min_conductance, stats.time,
+                        thread_id);
+                    stats_buffer.append(line, size);
+                }
+            }
+        }
+        nb_pushes += ppr ? ppr->get_nb_pushes() : 0;
+        if (stats_buffer.size() >= stats_buffer_size)
+        {
+            const auto start = Trace::clock::now();
+            std::lock_guard<std::mutex> locker(m_stats_mutex);
+            m_stats_file << stats_buffer;
+            stats_buffer.clear();
+            trace_buffer.add("write seeds statistics", "io", start,
+                Trace::clock::now());
+        }
+    }
 
-    if (thread_id >= nb_threads - rem)
+    if (!stats_buffer.empty())
     {
-        starting_seed += thread_id - (nb_threads - rem);
-        final_seed += thread_id - (nb_threads - rem - 1);
+        const auto start = Trace::clock::now();
+        std::lock_guard<std::mutex> locker(m_stats_mutex);
+        m_stats_file << stats_buffer;
+        trace_buffer.add("write seeds statistics", "io", start,
+            Trace::clock::now());
     }
 
-    for (unsigned int i = starting_seed; i < final_seed; ++i)
+    m_nb_expansions += nb_expansions;
+    m_nb_pushes += nb_pushes;
+    counters.stop();
+    m_thread_counters[thread_id] = counters.get_values();
+}
+
+
+std::vector<unsigned int> Nise::seeding_by_graclus_centers(
+    const Graph &bcore_g, Concurrent_queue<seed_entry> &seeds_q) const
+{
+    auto labels = utils::graclus::partition(bcore_g, m_nb_seeds);
+    auto seeds = utils::graclus::centers(bcore_g, labels);
+    for (unsigned int i = 0; i < seeds.size(); ++i)
     {
-        shared_clst_insertion(seed_expansion_by_ppr(bcore_g,bcore_v, seeds[i]));
+        seeds_q.push({seeds[i], i});
     }
+
+    if (seeds.size() < m_nb_seeds && m_p.verbose())
+    {
+        std::cout << "[WARNING] Nise::seeding_by_graclus_centers: it was not "
+            "possible to find all seeds. Expected: " << m_nb_seeds <<
+            ". Found: " << seeds.size() << "\n";
+    }
+
+    return seeds;
 }
 
 
-std::vector<unsigned int> 
-    Nise::seeding_by_spread_hubs(const Graph &bcore_g) const
+std::vector<unsigned int> Nise::seeding_by_spread_hubs(
+    const Graph &bcore_g, Concurrent_queue<seed_entry> &seeds_q) const
 {
     // it needs test
     std::vector<unsigned int> decreasing_degree(bcore_g.get_nb_vertices());
@@ -576,10 +1281,10 @@ std::vector<unsigned int>
         });
 
     std::vector<unsigned int> seeds;
-    seeds.reserve(2 * m_p.nb_of_seeds());
+    seeds.reserve(2 * m_nb_seeds);
 
     unsigned int i = 0;
-    while (seeds.size() < m_p.nb_of_seeds() && i < bcore_g.get_nb_vertices())
+    while (seeds.size() < m_nb_seeds && i < bcore_g.get_nb_vertices())
     {
         if (!marked[decreasing_degree[i]]) // unmarked (unvisited) vertex
         {
@@ -587,9 +1292,11 @@ std::vector<unsigned int>
              * "decreasing_degree" vector) with same degree as the ith vtx */
             auto vertices = 
                 independent_set_of(bcore_g, decreasing_degree, marked, i);
+            const unsigned int rank = seeds.size(); // same for the whole set
 
             for (auto v : vertices)
             {
+                seeds_q.push({v, rank}); // it can be expanded right away
                 seeds.push_back(v); // put vertex in seeds vector
                 // mark vertex and its neighbors as visited
                 mark_vertex_neighborhood(v, bcore_g, marked);
@@ -599,10 +1306,11 @@ std::vector<unsigned int>
     }
 
 
-    if (i >= bcore_g.get_nb_vertices() && seeds.size() < m_p.nb_of_seeds())
+    if (i >= bcore_g.get_nb_vertices() && seeds.size() < m_nb_seeds &&
+        m_p.verbose())
     {
         std::cout << "[WARNING] Nise::seeding_by_spread_hubs: it was not "
-            "possible to find all seeds. Expected: " << m_p.nb_of_seeds() <<
+            "possible to find all seeds. Expected: " << m_nb_seeds <<
             ". Found: " << seeds.size() << "\n";
     }
 
@@ -610,18 +1318,118 @@ std::vector<unsigned int>
 }
 
 
-std::vector<unsigned int> Nise::seeding_phase(const Graph &bcore_g) const
+std::vector<unsigned int> Nise::seeding_phase(const Graph &bcore_g,
+    Concurrent_queue<seed_entry> &seeds_q) const
 {
-    std::cout << "\t\tseeding phase...\n";
+    if (m_p.verbose())
+    {
+        std::cout << "\t\tseeding phase...\n";
+    }
 
-    // TODO: implement graclus.
+    std::vector<unsigned int> seeds;
+    if (m_given_seeds) // see execute(seeds, alpha, epsilon)
+    {
+        for (unsigned int i = 0; i < m_seeds.size(); ++i)
+        {
+            seeds_q.push({m_seeds[i], i});
+        }
+        seeds_q.close();
+        return m_seeds;
+    }
 
-    return seeding_by_spread_hubs(bcore_g);
+    switch (m_p.get_seeding_method())
+    {
+        default:
+        {
+            std::cerr << "Nise::seeding_phase: invalid seeding method!\n";
+            exit(EXIT_FAILURE);
+        }
+        case Nise_parameters::seeding_method::spread_hubs :
+        {
+            seeds = seeding_by_spread_hubs(bcore_g, seeds_q);
+            break;
+        }
+        case Nise_parameters::seeding_method::graclus_centers :
+        {
+            seeds = seeding_by_graclus_centers(bcore_g, seeds_q);
+            break;
+        }
+    }
+
+    seeds_q.close(); // no more seeds, the expansion threads can finish
+
+    return seeds;
 }
 
 
-void Nise::shared_clst_insertion(const Cluster &clst)
+void Nise::shared_clst_insertion(Cluster &&clst,
+    const unsigned int config_id, Trace::Thread_buffer &trace_buffer)
 {
+    if (m_stream_q)
+    {
+        // the propagation phase by the whisker mapping (see [1])
+        std::vector<unsigned int> vertices(clst.begin(), clst.end());
+        for (auto v : clst)
+        {
+            auto it = m_whisker_map.find(v);
+            if (it != m_whisker_map.end())
+            {
+                vertices.insert(vertices.end(), it->second.begin(),
+                    it->second.end());
+            }
+        }
+        std::sort(vertices.begin(), vertices.end());
+        const auto start = Trace::clock::now();
+        m_stream_q->push({config_id, format_clst_line(vertices)});
+        trace_buffer.add("queue push", "lock", start, Trace::clock::now());
+        return;
+    }
+
+    const auto start = Trace::clock::now();
     std::lock_guard<std::mutex> locker(m_mutex);
-    m_clusters.insert(clst);
+    trace_buffer.add("lock wait", "lock", start, Trace::clock::now());
+    if (m_p.dedup())
+    {
+        // neighboring seeds often expand to the same cluster
+        auto &expanded = m_expanded_clsts[config_id];
+        auto range = m_expanded_fps[config_id].equal_range(
+            clst.get_fingerprint());
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (expanded[it->second].size() == clst.size() &&
+                expanded[it->second] == clst)
+            {
+                return; // repeated cluster
+            }
+        }
+        m_expanded_fps[config_id].emplace(clst.get_fingerprint(),
+            expanded.size());
+    }
+    m_expanded_clsts[config_id].push_back(std::move(clst));
+}
+
+
+void Nise::write_checkpoint(const std::vector<bool> &contained_in_bcore,
+    const std::vector<Graph::edge> &bridges,
+    const std::vector<unsigned int> &seeds) const
+{
+    if (m_p.verbose())
+    {
+        std::cout << "\t\twriting checkpoint...\n";
+    }
+    Nise_checkpoint ckpt;
+    ckpt.nb_vertices = m_graph.get_nb_vertices();
+    ckpt.nb_edges = m_graph.get_nb_edges();
+    ckpt.alpha = m_p.alpha();
+    ckpt.epsilon = m_p.epsilon();
+    ckpt.seeding_method = m_p.get_seeding_method();
+    ckpt.contained_in_bcore = contained_in_bcore;
+    ckpt.bridges = bridges;
+    ckpt.seeds = seeds;
+    ckpt.clusters.reserve(m_clusterings.front().size());
+    for (const auto &id_c : m_clusterings.front())
+    {
+        ckpt.clusters.emplace_back(id_c.second.begin(), id_c.second.end());
+    }
+    ckpt.write(m_p.get_checkpoint_path());
 }
\ No newline at end of file
@@ -15,7 +15,12 @@
  */
 
 #include "../headers/nise_parameters.hpp"
+#include <algorithm>
 #include <experimental/filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 
 
 /////////////////////////////// Helper functions ///////////////////////////////
@@ -46,6 +51,24 @@ bool is_number(const std::string &str)
 ////////////////////////////////////////////////////////////////////////////////
 
 
+Nise_parameters::Nise_parameters(const configuration &config)
+{
+    if (!set_configuration(config))
+    {
+        throw std::invalid_argument("Nise_parameters: invalid configuration");
+    }
+    m_flag_val_map["-i"] = 0; // a library does not print on its host output
+}
+
+
+bool Nise_parameters::is_valid(const double alpha, const double epsilon)
+{
+    // the push method does not converge for alpha = 1 and the pushes grow as
+    // 1 / epsilon (see [1])
+    return alpha > 0 && alpha < 1 && epsilon > 0 && epsilon <= 1;
+}
+
+
 double Nise_parameters::alpha() const
 {
     return m_flag_val_map.at("-a");
@@ -58,12 +81,123 @@ double Nise_parameters::epsilon() const
 }
 
 
+bool Nise_parameters::dedup() const
+{
+    return m_flag_val_map.at("-d") != 0;
+}
+
+
+double Nise_parameters::jaccard_threshold() const
+{
+    return m_flag_val_map.at("-j");
+}
+
+
+bool Nise_parameters::warm_start() const
+{
+    return m_flag_val_map.at("-r") != 0;
+}
+
+
+bool Nise_parameters::verbose() const
+{
+    return m_flag_val_map.at("-i") != 0;
+}
+
+
+bool Nise_parameters::streaming() const
+{
+    return m_flag_val_map.at("-l") != 0;
+}
+
+
+bool Nise_parameters::profiling() const
+{
+    return m_flag_val_map.at("-p") != 0;
+}
+
+
 unsigned int Nise_parameters::nb_of_seeds() const
 {
     return m_nb_of_seeds;
 }
 
 
+unsigned int Nise_parameters::nb_threads() const
+{
+    return m_nb_threads > 0 ? m_nb_threads :
+        std::max(1u, std::thread::hardware_concurrency());
+}
+
+
+std::vector<Nise_parameters::configuration>
+    Nise_parameters::get_configurations() const
+{
+    if (m_sweep.empty())
+    {
+        return {{alpha(), epsilon(), m_nb_of_seeds}};
+    }
+
+    auto configs = m_sweep;
+    for (auto &c : configs)
+    {
+        if (c.nb_seeds == 0)
+        {
+            c.nb_seeds = m_nb_of_seeds;
+        }
+    }
+    return configs;
+}
+
+
+Nise_parameters::seeding_method Nise_parameters::get_seeding_method() const
+{
+    return m_seeding_method;
+}
+
+
+std::string Nise_parameters::get_checkpoint_path() const
+{
+    return m_checkpoint_path;
+}
+
+
+std::string Nise_parameters::get_output_path() const
+{
+    return m_output_path;
+}
+
+
+std::string Nise_parameters::get_binary_output_path() const
+{
+    return m_binary_output_path;
+}
+
+
+std::string Nise_parameters::get_stats_path() const
+{
+    return m_stats_path;
+}
+
+
+std::string Nise_parameters::get_trace_path() const
+{
+    return m_trace_path;
+}
+
+
+std::string Nise_parameters::get_socket_path() const
+{
+    return m_socket_path;
+}
+
+
+double Nise_parameters::job_time_limit() const
+{
+    return m_job_time_limit;
+}
+
+
 std::string Nise_parameters::get_graph_path() const
 {
     return m_graph_path;
@@ -72,7 +206,7 @@ std::string Nise_parameters::get_graph_path() const
 
 bool Nise_parameters::set_parameters(const int argc, char** argv)
 {
-    if (argc < 5 || argc > 9 || (argc - 1) % 2 != 0) // argc - 1 must be even
+    if (argc < 5 || (argc - 1) % 2 != 0) // argc - 1 must be even
     {
         std::cerr << "[ERROR] Wrong number of parameters.\n";
         return false;
@@ -118,15 +252,115 @@ bool Nise_parameters::set_parameters(const int argc, char** argv)
         }
     }
 
+    return check_flags();
+}
+
+
+bool Nise_parameters::set_configuration(const configuration &config)
+{
+    if (!is_valid(config.alpha, config.epsilon) || config.nb_seeds < 1)
+    {
+        return false;
+    }
+
+    m_sweep.clear();
+    m_flag_val_map["-a"] = config.alpha;
+    m_flag_val_map["-e"] = config.epsilon;
+    m_nb_of_seeds = config.nb_seeds;
+
     return true;
 }
 
 
-/////////////////////////////// private methods ////////////////////////////////
+bool Nise_parameters::check_flags() const
+{
+    // the checkpoint stores a single configuration
+    if (!m_sweep.empty() && !m_checkpoint_path.empty())
+    {
+        std::cerr << "[ERROR] Flags -c and -w can not be used together.\n";
+        return false;
+    }
+
+    // the Graclus centers of k_max seeds do not contain the ones of k seeds
+    if (!m_sweep.empty() &&
+        m_seeding_method == seeding_method::graclus_centers)
+    {
+        std::cerr << "[ERROR] Flags -m graclus and -w can not be used "
+            "together.\n";
+        return false;
+    }
+
+    // these flags need all clusters in memory
+    if (streaming() && (!m_checkpoint_path.empty() ||
+        !m_binary_output_path.empty() || dedup() || jaccard_threshold() > 0))
+    {
+        std::cerr << "[ERROR] Flag -l 1 can not be used with flags -c, -b, "
+            "-d 1 or -j.\n";
+        return false;
+    }
+
+    // the server returns the clusterings of a single configuration
+    if (!m_socket_path.empty() && (!m_checkpoint_path.empty() ||
+        !m_sweep.empty() || streaming()))
+    {
+        std::cerr << "[ERROR] Flag -u can not be used with flags -c, -w or "
+            "-l 1.\n";
+        return false;
+    }
+
+    return true;
+}
 
 
 bool Nise_parameters::set(const std::string &flag, const std::string &val_str)
 {
+    if (flag == "-m")
+    {
+        return set_seeding_method(val_str);
+    }
+    else if (flag == "-c")
+    {
+        m_checkpoint_path = val_str;
+        return true;
+    }
+    else if (flag == "-w")
+    {
+        return set_sweep(val_str);
+    }
+    else if (flag == "-o")
+    {
+        m_output_path = val_str;
+        return !m_output_path.empty();
+    }
+    else if (flag == "-b")
+    {
+        m_binary_output_path = val_str;
+        return !m_binary_output_path.empty();
+    }
+    else if (flag == "-x")
+    {
+        m_stats_path = val_str;
+        return !m_stats_path.empty();
+    }
+    else if (flag == "-t")
+    {
+        m_trace_path = val_str;
+        return !m_trace_path.empty();
+    }
+    else if (flag == "-n")
+    {
+        return set_nb_threads(val_str);
+    }
+    else if (flag == "-q")
+    {
+        return set_job_time_limit(val_str);
+    }
+    else if (flag == "-u")
+    {
+        m_socket_path = val_str;
+        return !m_socket_path.empty();
+    }
+
     auto it = m_flag_val_map.find(flag);
     if (it == m_flag_val_map.end()) // checks if the flag is valid
     {
@@ -143,6 +377,11 @@ bool Nise_parameters::set(const std::string &flag, const std::string &val_str)
     {
         return false;
     }
+    if ((flag == "-a" && !is_valid(val_d, epsilon())) ||
+        (flag == "-e" && !is_valid(alpha(), val_d)))
+    {
+        return false;
+    }
 
     (*it).second = val_d;
 
@@ -150,6 +389,9 @@ bool Nise_parameters::set(const std::string &flag, const std::string &val_str)
 }
 
 
+/////////////////////////////// private methods ////////////////////////////////
+
+
 bool Nise_parameters::set_nb_of_seeds(const std::string &val_str)
 {
     if (!is_number(val_str)) // checks whether the value is a valid number
@@ -169,6 +411,97 @@ bool Nise_parameters::set_nb_of_seeds(const std::string &val_str)
 }
 
 
+bool Nise_parameters::set_nb_threads(const std::string &val_str)
+{
+    if (!is_number(val_str)) // checks whether the value is a valid number
+    {
+        return false;
+    }
+
+    int val_i = std::stoi(val_str);
+    if (val_i < 1) // checks whether the value is in the range
+    {
+        return false;
+    }
+
+    m_nb_threads = static_cast<unsigned int>(val_i);
+
+    return true;
+}
+
+
+bool Nise_parameters::set_job_time_limit(const std::string &val_str)
+{
+    if (!is_number(val_str)) // checks whether the value is a valid number
+    {
+        return false;
+    }
+
+    const double val_d = std::stod(val_str);
+    if (val_d <= 0) // checks whether the value is in the range
+    {
+        return false;
+    }
+
+    m_job_time_limit = val_d;
+
+    return true;
+}
+
+
+bool Nise_parameters::set_sweep(const std::string &path)
+{
+    std::ifstream f(path);
+    if (!f)
+    {
+        return false;
+    }
+
+    m_sweep.clear();
+    std::string line;
+    while (std::getline(f, line))
+    {
+        std::istringstream ss(line);
+        configuration c = {0, 0, 0};
+        if (!(ss >> c.alpha))
+        {
+            continue; // empty line
+        }
+        if (!(ss >> c.epsilon) || !is_valid(c.alpha, c.epsilon))
+        {
+            return false;
+        }
+        int nb_seeds = 0;
+        if (ss >> nb_seeds && nb_seeds < 1)
+        {
+            return false;
+        }
+        c.nb_seeds = static_cast<unsigned int>(nb_seeds);
+        m_sweep.push_back(c);
+    }
+
+    return !m_sweep.empty();
+}
+
+
+bool Nise_parameters::set_seeding_method(const std::string &val_str)
+{
+    if (val_str == "sph")
+    {
+        m_seeding_method = seeding_method::spread_hubs;
+    }
+    else if (val_str == "graclus")
+    {
+        m_seeding_method = seeding_method::graclus_centers;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+
 bool Nise_parameters::set_graph_path(const std::string &path)
 {
     if (!std::experimental::filesystem::exists(path))
@@ -0,0 +1,448 @@
+/*
+ * File: nise_server.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Implementation of the server mode of NISE-SPH.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 20, 2026, 02:55 AM
+ */
+
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include "../headers/nise_server.hpp"
+#include "../headers/time_mgmt.hpp"
+
+
+/////////////////////////////// Helper functions ///////////////////////////////
+
+namespace
+{
+
+const int listen_backlog = 64; // magic number
+const int request_timeout_sec = 10; // magic number
+const int poll_timeout_ms = 1000; // magic number
+const std::size_t max_request_size = 1 << 26; // magic number
+
+/**
+ * @brief Parse a whole string as a number.
+ * @param const std::string &: string.
+ * @param T &: output number.
+ * @return bool: true if the whole string is a valid number.
+*/
+template <typename T>
+bool parse_number(const std::string &str, T &val)
+{
+    const char *end = str.data() + str.size();
+    auto result = std::from_chars(str.data(), end, val);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+/**
+ * @brief State of the request of a connection (see read_available).
+*/
+enum class request_status {complete, pending, failed};
+
+/**
+ * @brief Read the data available in a non-blocking connection and append it
+ * to its request.
+ * @param const int: connection socket.
+ * @param std::string &: request read so far. Once complete, it is the request
+ * line without the newline.
+ * @return request_status: complete if the newline (or the end of the
+ * connection) was read, pending if more data is expected, or failed if the
+ * connection failed or the request is too large.
+*/
+request_status read_available(const int fd, std::string &request)
+{
+    char buffer[4096];
+    while (true)
+    {
+        const ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            return request_status::pending;
+        }
+        if (n <= 0)
+        {
+            return n == 0 && !request.empty() ? request_status::complete :
+                request_status::failed;
+        }
+        request.append(buffer, n);
+        const std::size_t newline = request.find('\n');
+        if (newline != std::string::npos)
+        {
+            request.resize(newline > 0 && request[newline - 1] == '\r' ?
+                newline - 1 : newline);
+            return request_status::complete;
+        }
+        if (request.size() > max_request_size)
+        {
+            return request_status::failed;
+        }
+    }
+}
+
+/**
+ * @brief Make a connection blocking again, with a send timeout, so a client
+ * that does not read its response does not block the worker forever.
+ * @param const int: connection socket.
+*/
+void set_blocking(const int fd)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+    timeval timeout = {request_timeout_sec, 0};
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+}
+
+/**
+ * @brief Send a whole string through a connection. A client that closed the
+ * connection does not raise SIGPIPE.
+ * @param const int: connection socket.
+ * @param const std::string &: data.
+ * @return bool: true if all data was sent.
+*/
+bool send_all(const int fd, const std::string &data)
+{
+    std::size_t sent = 0;
+    while (sent < data.size())
+    {
+        const ssize_t n = send(fd, data.data() + sent, data.size() - sent,
+            MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        sent += n;
+    }
+    return true;
+}
+
+/**
+ * @brief Open the listening socket. A stale socket file of a previous server
+ * is removed, but any other file in the path is kept.
+ * @param const std::string &: socket path.
+ * @return int: listening socket or -1 if it was not possible to open it.
+*/
+int open_socket(const std::string &path)
+{
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path))
+    {
+        std::cerr << "[ERROR] Nise_server: the socket path is too long.\n";
+        return -1;
+    }
+    std::strcpy(addr.sun_path, path.c_str());
+
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0)
+    {
+        if (!S_ISSOCK(st.st_mode))
+        {
+            std::cerr << "[ERROR] Nise_server: " << path << " exists and is "
+                "not a socket.\n";
+            return -1;
+        }
+        unlink(path.c_str());
+    }
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (fd < 0)
+    {
+        std::cerr << "[ERROR] Nise_server: socket: " << std::strerror(errno) <<
+            ".\n";
+        return -1;
+    }
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(fd, listen_backlog) < 0)
+    {
+        std::cerr << "[ERROR] Nise_server: it was not possible to listen on " <<
+            path << ": " << std::strerror(errno) << ".\n";
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+Nise_server::Nise_server(const Graph &g, const Nise_parameters &params) :
+    m_p(params),
+    m_nise(g, params)
+{
+    m_nise.set_time_limit(m_p.job_time_limit());
+}
+
+
+bool Nise_server::run()
+{
+    m_nise.prepare(); // the jobs start from the seeding phase
+
+    const std::string path = m_p.get_socket_path();
+    const int listen_fd = open_socket(path);
+    if (listen_fd < 0)
+    {
+        return false;
+    }
+    std::cout << "Serving on " << path << "...\n";
+
+    // the connections are non-blocking and polled, so a client that does not
+    // send its request does not block the others
+    std::vector<connection> connections;
+    std::vector<pollfd> fds;
+    std::thread worker(&Nise_server::worker_thread_task, this);
+    bool stopped = false;
+    bool failed = false;
+    while (!stopped && !failed)
+    {
+        fds.assign(1, {listen_fd, POLLIN, 0});
+        for (const auto &c : connections)
+        {
+            fds.push_back({c.fd, POLLIN, 0});
+        }
+        if (poll(fds.data(), fds.size(), poll_timeout_ms) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            std::cerr << "[ERROR] Nise_server: poll: " <<
+                std::strerror(errno) << ".\n";
+            break;
+        }
+
+        // the connections are read before the new ones are appended
+        const auto now = std::chrono::steady_clock::now();
+        std::vector<connection> pending;
+        for (std::size_t i = 0; i < connections.size(); ++i)
+        {
+            auto &c = connections[i];
+            auto status = request_status::pending;
+            if (fds[i + 1].revents != 0)
+            {
+                status = read_available(c.fd, c.request);
+            }
+            if (status == request_status::pending &&
+                now - c.start > std::chrono::seconds(request_timeout_sec))
+            {
+                status = request_status::failed;
+            }
+
+            if (status == request_status::pending || stopped)
+            {
+                pending.push_back(std::move(c));
+            }
+            else if (status == request_status::failed)
+            {
+                close(c.fd);
+            }
+            else if (c.request == "stop")
+            {
+                // the queued jobs are done before the server stops
+                m_jobs.close();
+                worker.join();
+                set_blocking(c.fd);
+                send_all(c.fd, "OK\n");
+                close(c.fd);
+                stopped = true;
+            }
+            else
+            {
+                set_blocking(c.fd); // the worker sends the response at once
+                m_jobs.push({c.fd, c.request});
+            }
+        }
+        connections.swap(pending);
+
+        if (!stopped && (fds[0].revents & POLLIN))
+        {
+            while (true)
+            {
+                const int fd = accept4(listen_fd, nullptr, nullptr,
+                    SOCK_NONBLOCK);
+                if (fd >= 0)
+                {
+                    connections.push_back({fd, std::string(), now});
+                }
+                else if (errno != EINTR && errno != ECONNABORTED)
+                {
+                    if (errno != EAGAIN && errno != EWOULDBLOCK)
+                    {
+                        std::cerr << "[ERROR] Nise_server: accept: " <<
+                            std::strerror(errno) << ".\n";
+                        failed = true;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    for (const auto &c : connections)
+    {
+        close(c.fd);
+    }
+    if (!stopped)
+    {
+        m_jobs.close();
+        worker.join();
+    }
+    close(listen_fd);
+    unlink(path.c_str());
+
+    return stopped;
+}
+
+
+/////////////////////////////// private methods ////////////////////////////////
+
+
+bool Nise_server::parse_request(const std::string &request,
+    job_config &config) const
+{
+    config = {m_p.nb_of_seeds(), m_p.alpha(), m_p.epsilon(), {}, false};
+
+    std::istringstream ss(request);
+    std::string flag;
+    std::string val;
+    bool empty = true;
+    while (ss >> flag)
+    {
+        empty = false;
+        if (!(ss >> val))
+        {
+            return false;
+        }
+
+        if (flag == "-s")
+        {
+            if (!parse_number(val, config.nb_seeds) || config.nb_seeds < 1)
+            {
+                return false;
+            }
+        }
+        else if (flag == "-a" || flag == "-e")
+        {
+            double &x = flag == "-a" ? config.alpha : config.epsilon;
+            if (!parse_number(val, x))
+            {
+                return false;
+            }
+        }
+        else if (flag == "-v")
+        {
+            std::istringstream vs(val);
+            std::string v_str;
+            while (std::getline(vs, v_str, ','))
+            {
+                unsigned int v;
+                if (!parse_number(v_str, v))
+                {
+                    return false;
+                }
+                config.seeds.push_back(v);
+            }
+            config.given_seeds = true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return !empty && Nise_parameters::is_valid(config.alpha, config.epsilon);
+}
+
+
+std::string Nise_server::process(const std::string &request)
+{
+    job_config config;
+    if (!parse_request(request, config))
+    {
+        return "ERROR invalid request\n";
+    }
+
+    utils::time_mgmt tmgmt;
+    tmgmt.start();
+    if (config.given_seeds)
+    {
+        m_nise.execute(config.seeds, config.alpha, config.epsilon);
+    }
+    else
+    {
+        m_nise.execute(config.nb_seeds, config.alpha, config.epsilon);
+    }
+    tmgmt.end();
+
+    if (m_nise.timed_out())
+    {
+        std::cout << "Job \"" << request << "\": time limit exceeded.\n";
+        return "ERROR time limit exceeded\n";
+    }
+
+    // the clusters in the clustering file format
+    const Clustering &clustering = m_nise.get_clusterings().front();
+    std::string response = "OK " + std::to_string(clustering.size()) + " " +
+        std::to_string(tmgmt.get_total_time_in_sec()) + "\n";
+    char number[16];
+    for (const auto &id_c : clustering)
+    {
+        bool first = true;
+        for (const auto v : id_c.second)
+        {
+            if (!first)
+            {
+                response += ' ';
+            }
+            first = false;
+            response.append(number,
+                std::to_chars(number, number + sizeof(number), v).ptr);
+        }
+        response += '\n';
+    }
+
+    std::cout << "Job \"" << request << "\": " << clustering.size() <<
+        " clusters in " << tmgmt.get_total_time_in_sec() << " seconds.\n";
+
+    return response;
+}
+
+
+void Nise_server::worker_thread_task()
+{
+    job j;
+    while (m_jobs.pop(j))
+    {
+        if (!send_all(j.fd, process(j.request)))
+        {
+            std::cerr << "[WARNING] Nise_server: the response of the job \"" <<
+                j.request << "\" was not sent.\n";
+        }
+        close(j.fd);
+    }
+}
@@ -0,0 +1,142 @@
+/*
+ * File: perf_counters.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Implementation of the hardware performance counters.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 11:40 PM
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "../headers/perf_counters.hpp"
+
+
+/////////////////////////////// Helper functions ///////////////////////////////
+
+namespace
+{
+
+/**
+ * @brief Counted events: name, perf type and perf config.
+*/
+struct event
+{
+    const char *name;
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+const event events[] =
+{
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"cache_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {"task_clock_ns", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK}
+};
+
+/**
+ * @brief Read a counter: value, time enabled and time running.
+ * @param const int: counter file descriptor.
+ * @param std::uint64_t *: output array of size 3.
+*/
+void read_counter(const int fd, std::uint64_t *data)
+{
+    if (read(fd, data, 3 * sizeof(std::uint64_t)) !=
+        3 * sizeof(std::uint64_t))
+    {
+        data[0] = data[1] = data[2] = 0;
+    }
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+Perf_counters::~Perf_counters()
+{
+    for (const auto &c : m_counters)
+    {
+        close(c.fd);
+    }
+}
+
+
+bool Perf_counters::open(const bool inherit)
+{
+    if (!m_counters.empty())
+    {
+        return true; // already opened (e.g. by a previous execution)
+    }
+
+    for (const auto &e : events)
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = e.type;
+        attr.config = e.config;
+        attr.disabled = 1;
+        attr.inherit = inherit ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+            PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // calling thread (pid 0) on any cpu (-1)
+        const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0,
+            -1, -1, 0));
+        if (fd >= 0)
+        {
+            m_counters.push_back({e.name, fd, 0, {0, 0, 0}});
+        }
+    }
+    return !m_counters.empty();
+}
+
+
+void Perf_counters::start()
+{
+    // the reset does not clear the counts of the exited inherited threads, so
+    // the values are the differences from a baseline read
+    for (auto &c : m_counters)
+    {
+        read_counter(c.fd, c.base);
+        ioctl(c.fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+
+void Perf_counters::stop()
+{
+    for (auto &c : m_counters)
+    {
+        ioctl(c.fd, PERF_EVENT_IOC_DISABLE, 0);
+        std::uint64_t data[3];
+        read_counter(c.fd, data);
+        const std::uint64_t enabled = data[1] - c.base[1];
+        const std::uint64_t running = data[2] - c.base[2];
+        c.value = running == 0 ? 0 : static_cast<unsigned long long>(
+            (data[0] - c.base[0]) * (static_cast<double>(enabled) / running));
+    }
+}
+
+
+std::vector<std::pair<std::string, unsigned long long>>
+    Perf_counters::get_values() const
+{
+    std::vector<std::pair<std::string, unsigned long long>> values;
+    for (const auto &c : m_counters)
+    {
+        values.emplace_back(c.name, c.value);
+    }
+    return values;
+}
@@ -0,0 +1,162 @@
+/*
+ * File: ppr.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Implementation of the approximate personalized PageRank vector.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 05:34 PM
+ *
+ * References:
+ * [1] J. J. Whang, D. F. Gleich and I. S. Dhillon. Overlapping community
+ * detection using neighborhood-inflated seed expansion, IEEE Transactions on
+ * Knowledge and Data Engineering 28(5) (2016) p. 1272-1284.
+ * [2] R. Andersen, F. Chung and K. Lang. Local Graph Partitioning using
+ * PageRank Vectors. In: Proceedings of the 47th Annual IEEE Symposium on
+ * Foundations of Computer Science. Berkeley, CA, USA: IEEE, 2006.
+ */
+
+#include <limits>
+#include <queue>
+#include <set>
+#include "../headers/ppr.hpp"
+
+
+/////////////////////////////// Helper functions ///////////////////////////////
+
+namespace
+{
+
+const unsigned int pushes_per_deadline_check = 1024; // magic number
+
+/**
+* @brief (see [1,2]).
+* @param const unsigned int: vertex index to add in queue.
+* @param std::queue<unsigned int> &: queue that holds vertices indices.
+* @param std::set<unsigned int> &: auxiliary data structure to track uniqueness.
+*/
+void add_in_epsilon_approx_queue(const unsigned int v,
+    std::queue<unsigned int> &q, std::set<unsigned int> &s)
+{
+    if (s.find(v) == s.end())
+    {
+        q.push(v);
+        s.insert(v);
+    }
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+Ppr_vector::Ppr_vector(const Graph &g, const unsigned int seed,
+    const double alpha) :
+    m_graph(g),
+    m_seed(seed),
+    m_alpha(alpha),
+    m_epsilon(std::numeric_limits<double>::infinity()),
+    m_nb_pushes(0)
+{
+    // initialize x and r of vertex seed and its neighboors
+    m_x[seed] = 0;
+    m_r[seed] = 1.0 / static_cast<double>(m_graph.get_vtx_degree(seed) + 1);
+    auto adj_list = m_graph.adj_list_of_vtx(seed);
+    for (auto it = adj_list.first; it != adj_list.second; ++it)
+    {
+        m_x[*it] = 0;
+        m_r[*it] = 1.0 / static_cast<double>(m_graph.get_vtx_degree(seed) + 1);
+    }
+}
+
+
+bool Ppr_vector::approximate(const double epsilon,
+    const std::chrono::steady_clock::time_point deadline)
+{
+    if (epsilon >= m_epsilon)
+    {
+        return true; // already approximated with this tolerance
+    }
+    const bool limited =
+        deadline != std::chrono::steady_clock::time_point::max();
+
+    // queue of vertices used in next loop as presented by [2]
+    std::queue<unsigned int> q;
+    std::set<unsigned int> s; // auxiliary data structure to track uniqueness
+    for (auto it = m_r.begin(); it != m_r.end(); ++it)
+    {
+        if ((*it).second > m_graph.get_vtx_degree((*it).first) * epsilon)
+        {
+            add_in_epsilon_approx_queue((*it).first, q, s);
+        }
+    }
+
+    // compute and update x and r values
+    while (!q.empty()) // while there is a v such that r[v] > deg(v) * epsilon
+    {
+        unsigned int v = q.front();
+        if (limited && m_nb_pushes % pushes_per_deadline_check == 0 &&
+            std::chrono::steady_clock::now() >= deadline)
+        {
+            return false;
+        }
+        ++m_nb_pushes;
+        m_x[v] += (1 - m_alpha) * m_r[v];
+        auto adj_list = m_graph.adj_list_of_vtx(v);
+        for (auto it_u = adj_list.first; it_u != adj_list.second; ++it_u)
+        {
+            m_r[*it_u] += (m_alpha * m_r[v]) / (2 * m_graph.get_vtx_degree(v));
+            if (m_r[*it_u] > m_graph.get_vtx_degree(*it_u) * epsilon)
+            {
+                add_in_epsilon_approx_queue(*it_u, q, s);
+            }
+        }
+        m_r[v] = m_alpha * m_r[v] / 2;
+        if (m_r[v] <= m_graph.get_vtx_degree(v) * epsilon)
+        {
+            // v is queued again if a later push raises its residual
+            q.pop();
+            s.erase(v);
+        }
+    }
+
+    m_epsilon = epsilon;
+    return true;
+}
+
+
+double Ppr_vector::get_alpha() const
+{
+    return m_alpha;
+}
+
+
+double Ppr_vector::get_epsilon() const
+{
+    return m_epsilon;
+}
+
+
+unsigned long long Ppr_vector::get_nb_pushes() const
+{
+    return m_nb_pushes;
+}
+
+
+std::size_t Ppr_vector::get_nb_touched() const
+{
+    return m_r.size();
+}
+
+
+unsigned int Ppr_vector::get_seed() const
+{
+    return m_seed;
+}
+
+
+const std::unordered_map<unsigned int, double>& Ppr_vector::get_x() const
+{
+    return m_x;
+}
@@ -0,0 +1,124 @@
+/*
+ * File: run_report.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Implementation of the run report.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 11:10 PM
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include "../headers/run_report.hpp"
+
+
+void Run_report::add_phase(const std::string &name, const utils::time_mgmt &t,
+    const counters &phase_counters)
+{
+    m_phases.push_back({name, t.get_total_time_in_sec(),
+        t.get_cpu_time_in_sec(), t.get_peak_rss_in_kb(), phase_counters});
+}
+
+
+void Run_report::set_field(const std::string &name,
+    const std::string &json_value)
+{
+    auto it = std::find_if(m_fields.begin(), m_fields.end(),
+        [&](const std::pair<std::string, std::string> &f)
+        {
+            return f.first == name;
+        });
+    if (it != m_fields.end())
+    {
+        it->second = json_value;
+        return;
+    }
+    m_fields.emplace_back(name, json_value);
+}
+
+
+double Run_report::get_wall_time(const std::string &name) const
+{
+    double wall_time = 0;
+    for (const auto &p : m_phases)
+    {
+        if (p.name == name)
+        {
+            wall_time += p.wall_time;
+        }
+    }
+    return wall_time;
+}
+
+
+std::string Run_report::quote(const std::string &str)
+{
+    std::string quoted = "\"";
+    for (const char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            quoted += '\\';
+            quoted += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20) // control character
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            quoted += escaped;
+        }
+        else
+        {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
+
+std::string Run_report::to_json(const counters &c)
+{
+    std::string json = "{";
+    for (std::size_t i = 0; i < c.size(); ++i)
+    {
+        json += (i == 0 ? "" : ", ") + quote(c[i].first) + ": " +
+            std::to_string(c[i].second);
+    }
+    return json + "}";
+}
+
+
+bool Run_report::write(const std::string &path) const
+{
+    std::ofstream f(path, std::fstream::trunc);
+    if (!f)
+    {
+        return false;
+    }
+
+    f << "{\n";
+    for (const auto &field : m_fields)
+    {
+        f << "  " << quote(field.first) << ": " << field.second << ",\n";
+    }
+    f << "  \"phases\": [";
+    for (std::size_t i = 0; i < m_phases.size(); ++i)
+    {
+        f << (i == 0 ? "\n" : ",\n") << "    {\"name\": " <<
+            quote(m_phases[i].name) << ", \"wall_time_sec\": " <<
+            m_phases[i].wall_time << ", \"cpu_time_sec\": " <<
+            m_phases[i].cpu_time << ", \"peak_rss_kb\": " <<
+            m_phases[i].peak_rss;
+        if (!m_phases[i].phase_counters.empty())
+        {
+            f << ", \"counters\": " << to_json(m_phases[i].phase_counters);
+        }
+        f << "}";
+    }
+    f << "\n  ]\n}\n";
+
+    return static_cast<bool>(f);
+}
@@ -0,0 +1,104 @@
+/*
+ * File: sweep.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Implementation of the sweep step of the seed expansion.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 20, 2026, 03:15 AM
+ *
+ * References:
+ * [1] J. J. Whang, D. F. Gleich and I. S. Dhillon. Overlapping community
+ * detection using neighborhood-inflated seed expansion, IEEE Transactions on
+ * Knowledge and Data Engineering 28(5) (2016) p. 1272-1284.
+ * [2] R. Andersen, F. Chung and K. Lang. Local Graph Partitioning using
+ * PageRank Vectors. In: Proceedings of the 47th Annual IEEE Symposium on
+ * Foundations of Computer Science. Berkeley, CA, USA: IEEE, 2006.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <set>
+#include "../headers/sweep.hpp"
+
+
+double utils::sweep::conductance(const unsigned int g_nb_edges,
+    const unsigned int vol, const unsigned int boundary_edges)
+{
+    assert(vol <= 2 * g_nb_edges);
+
+    unsigned int compl_vol = 2 * g_nb_edges - vol;
+    // prevent division by 0 see LNCS 3418 - Network Analysis
+    if (compl_vol == 0 || vol == 0)
+    {
+        return 1;
+    }
+
+    return static_cast<double>(boundary_edges) / std::min(vol, compl_vol);
+}
+
+
+std::vector<unsigned int> utils::sweep::sort_vertices_in_decreasing_ppd(
+    const std::unordered_map<unsigned int, double> &x, const Graph &bcore_g)
+{
+    std::vector<unsigned int> decreasing_ppd(x.size()); // vertices indices
+    unsigned int i = 0;
+    for (auto &e : x) // populate vector with vertices indices
+    {
+        decreasing_ppd[i++] = e.first;
+    }
+    std::sort(decreasing_ppd.begin(), decreasing_ppd.end(), // sort
+        [&](const unsigned int v1, const unsigned int v2)
+        {
+            return (x.at(v1) / static_cast<double>(bcore_g.get_vtx_degree(v1)))
+                > (x.at(v2) / static_cast<double>(bcore_g.get_vtx_degree(v2)));
+        });
+    return decreasing_ppd;
+}
+
+
+Cluster utils::sweep::clst_min_conductance(const Graph &original_g,
+    const Graph &bcore_g, const std::vector<unsigned int> &bcore_v,
+    const std::vector<unsigned int> &vertices_sppd, double &min_cond)
+{
+    std::set<unsigned int> sweep_set;
+    unsigned int clst_size = 0; // size of the sweep set of min conductance
+    unsigned int vol = 0;
+    unsigned int boundary_edges = 0;
+    min_cond = std::numeric_limits<double>::infinity();
+    for (unsigned int i = 0; i < vertices_sppd.size(); ++i)
+    {
+        // compute the number of boundary edges
+        sweep_set.insert(bcore_v[vertices_sppd[i]]); // insert original v label
+        auto adj_list = bcore_g.adj_list_of_vtx(vertices_sppd[i]);
+        for (auto it_adj = adj_list.first; it_adj != adj_list.second; ++it_adj)
+        {
+            if (sweep_set.find(bcore_v[*it_adj]) != sweep_set.end())
+            {
+                --boundary_edges;
+            }
+            else
+            {
+                ++boundary_edges;
+            }
+        }
+        vol += bcore_g.get_vtx_degree(vertices_sppd[i]);
+        // compute conductances
+        double cond = conductance(bcore_g.get_nb_edges(), vol, boundary_edges);
+        if (cond <= min_cond)
+        {
+            min_cond = cond;
+            clst_size = i + 1; // save set of vertices of minimum conductance
+        }
+    }
+
+    // cluster constructed from original graph vertices
+    std::vector<unsigned int> clst(clst_size);
+    for (unsigned int j = 0; j < clst_size; ++j)
+    {
+        clst[j] = bcore_v[vertices_sppd[j]];
+    }
+    return Cluster(original_g, std::move(clst));
+}
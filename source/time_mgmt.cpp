@@ -0,0 +1,83 @@
+/*
+ * File: time_mgmt.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Implementation of the code section timer.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 19, 2026, 10:50 PM
+ */
+
+#include <sys/resource.h>
+#include "../headers/time_mgmt.hpp"
+
+
+/////////////////////////////// Helper functions ///////////////////////////////
+
+namespace
+{
+
+/**
+ * @brief Get the CPU time (user and system) of the process.
+ * @return double: CPU time in seconds.
+*/
+double process_cpu_time()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+        (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+void utils::time_mgmt::start()
+{
+    m_start = std::chrono::steady_clock::now();
+    m_cpu_start = process_cpu_time();
+}
+
+
+void utils::time_mgmt::end()
+{
+    m_end = std::chrono::steady_clock::now();
+    m_cpu_end = process_cpu_time();
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    m_peak_rss = usage.ru_maxrss; // kilobytes on Linux
+}
+
+
+double utils::time_mgmt::get_cpu_time_in_sec() const
+{
+    return m_cpu_end - m_cpu_start;
+}
+
+
+std::chrono::steady_clock::time_point utils::time_mgmt::get_end_time() const
+{
+    return m_end;
+}
+
+
+long utils::time_mgmt::get_peak_rss_in_kb() const
+{
+    return m_peak_rss;
+}
+
+
+std::chrono::steady_clock::time_point utils::time_mgmt::get_start_time() const
+{
+    return m_start;
+}
+
+
+double utils::time_mgmt::get_total_time_in_sec() const
+{
+    return std::chrono::duration<double>(m_end - m_start).count();
+}
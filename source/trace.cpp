@@ -0,0 +1,130 @@
+/*
+ * File: trace.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Implementation of the run timeline in the Chrome trace event format.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 20, 2026, 12:25 AM
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include "../headers/run_report.hpp"
+#include "../headers/trace.hpp"
+
+
+Trace::Thread_buffer::Thread_buffer(Trace *trace, const unsigned int tid,
+    const std::string &name) :
+    m_trace(trace),
+    m_tid(tid)
+{
+    if (m_trace)
+    {
+        m_trace->set_thread_name(tid, name);
+    }
+}
+
+
+Trace::Thread_buffer::~Thread_buffer()
+{
+    flush();
+}
+
+
+void Trace::Thread_buffer::add(const std::string &name, const std::string &cat,
+    const clock::time_point start, const clock::time_point end,
+    const std::string &args)
+{
+    if (m_trace)
+    {
+        m_events.push_back({name, cat, start, end, m_tid, args});
+    }
+}
+
+
+bool Trace::Thread_buffer::enabled() const
+{
+    return m_trace != nullptr;
+}
+
+
+void Trace::Thread_buffer::flush()
+{
+    if (m_trace && !m_events.empty())
+    {
+        m_trace->add(std::move(m_events));
+        m_events.clear();
+    }
+}
+
+
+void Trace::add(std::vector<event> &&events)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    m_events.insert(m_events.end(), std::make_move_iterator(events.begin()),
+        std::make_move_iterator(events.end()));
+}
+
+
+void Trace::add(const std::string &name, const std::string &cat,
+    const clock::time_point start, const clock::time_point end,
+    const unsigned int tid)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    m_events.push_back({name, cat, start, end, tid, ""});
+}
+
+
+void Trace::set_thread_name(const unsigned int tid, const std::string &name)
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    m_thread_names[tid] = name;
+}
+
+
+bool Trace::write(const std::string &path) const
+{
+    std::lock_guard<std::mutex> locker(m_mutex);
+    std::ofstream f(path, std::fstream::trunc);
+    if (!f)
+    {
+        return false;
+    }
+
+    clock::time_point origin = clock::time_point::max();
+    for (const auto &e : m_events)
+    {
+        origin = std::min(origin, e.start);
+    }
+
+    f << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    for (const auto &tid_name : m_thread_names)
+    {
+        f << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", "
+            "\"ph\": \"M\", \"pid\": 1, \"tid\": " << tid_name.first <<
+            ", \"args\": {\"name\": " << Run_report::quote(tid_name.second) <<
+            "}}";
+        first = false;
+    }
+    f.precision(3);
+    f << std::fixed;
+    for (const auto &e : m_events)
+    {
+        f << (first ? "\n" : ",\n") << "{\"name\": " << Run_report::quote(
+            e.name) << ", \"cat\": " << Run_report::quote(e.cat) <<
+            ", \"ph\": \"X\", \"ts\": " <<
+            std::chrono::duration<double, std::micro>(e.start - origin).count()
+            << ", \"dur\": " <<
+            std::chrono::duration<double, std::micro>(e.end - e.start).count()
+            << ", \"pid\": 1, \"tid\": " << e.tid << ", \"args\": {" << e.args
+            << "}}";
+        first = false;
+    }
+    f << "\n]}\n";
+
+    return static_cast<bool>(f);
+}
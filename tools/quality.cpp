@@ -0,0 +1,404 @@
+/*
+ * File: quality.cpp
+ * Author: Guilherme O. Chagas
+ *
+ * @brief Clustering quality evaluator: loads a graph and a clustering (e.g.
+ * the output of NISE-SPH) and computes the conductance of each cluster (by the
+ * Cluster degrees bookkeeping), the coverage (fraction of clustered vertices)
+ * and the average number of memberships of the clustered vertices. If a
+ * ground-truth clustering is given, the overlapping normalized mutual
+ * information (NMI) [1,2] and the average F1 score [3] against it are also
+ * computed. All metrics are computed in parallel (OpenMP).
+ *
+ * Usage: ./nise_quality -f <graph> -c <clustering> [flag] <value>, where the
+ * optional flags are "-g" ground-truth clustering file path, "-o" per-cluster
+ * CSV file path, "-r" JSON report file path and "-n" number of threads.
+ *
+ * (I'm sorry for my bad english xD)
+ *
+ * Created on October 20, 2026, 04:50 AM
+ *
+ * References:
+ * [1] A. Lancichinetti, S. Fortunato and J. Kertesz. Detecting the
+ * overlapping and hierarchical community structure in complex networks, New
+ * Journal of Physics 11(3) (2009) 033015.
+ * [2] A. F. McDaid, D. Greene and N. Hurley. Normalized mutual information to
+ * evaluate overlapping community finding algorithms. arXiv:1110.2515, 2011.
+ * [3] J. Yang and J. Leskovec. Overlapping community detection at scale: a
+ * nonnegative matrix factorization approach. In: Proceedings of the 6th ACM
+ * International Conference on Web Search and Data Mining. ACM, 2013.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <experimental/filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <omp.h>
+#include <string>
+#include <vector>
+#include "../headers/cluster.hpp"
+#include "../headers/clustering.hpp"
+#include "../headers/graph.hpp"
+#include "../headers/run_report.hpp"
+#include "../headers/sweep.hpp"
+#include "../headers/time_mgmt.hpp"
+
+
+/////////////////////////////// Helper functions ///////////////////////////////
+
+namespace
+{
+
+/**
+ * @brief Evaluator settings (see the file header).
+*/
+struct settings
+{
+    std::string graph_path;
+    std::string clustering_path;
+    std::string ground_truth_path;
+    std::string csv_path;
+    std::string report_path;
+    int nb_threads = 0;
+};
+
+/**
+ * @brief Best match of each cluster of a clustering in another clustering:
+ * the sum of the conditional entropies H(X_i|Y) of [2] (in bits), the sum of
+ * the normalized ones H(X_i|Y)/H(X_i) of [1] and of the best F1 scores [3],
+ * the sum of the entropies H(X_i) and the number of clusters with nonzero
+ * entropy.
+*/
+struct best_matches
+{
+    double cond_entropy = 0;
+    double norm_cond_entropy = 0;
+    double f1 = 0;
+    double entropy = 0;
+    unsigned int nb_clusters = 0;
+};
+
+/**
+ * @brief Set the evaluator settings from the terminal user input.
+ * @return bool: true if all flags are valid and the mandatory ones are set.
+*/
+bool set_settings(const int argc, char** argv, settings &s)
+{
+    if ((argc - 1) % 2 != 0)
+    {
+        return false;
+    }
+    std::map<std::string, std::string*> paths = {{"-f", &s.graph_path},
+        {"-c", &s.clustering_path}, {"-g", &s.ground_truth_path},
+        {"-o", &s.csv_path}, {"-r", &s.report_path}};
+    for (int i = 1; i < argc; i += 2)
+    {
+        const std::string flag = argv[i];
+        if (flag == "-n")
+        {
+            try
+            {
+                s.nb_threads = std::stoi(argv[i + 1]);
+            }
+            catch (...)
+            {
+                return false;
+            }
+            if (s.nb_threads < 1)
+            {
+                return false;
+            }
+            continue;
+        }
+        auto it = paths.find(flag);
+        if (it == paths.end())
+        {
+            return false;
+        }
+        *it->second = argv[i + 1];
+    }
+    for (const auto &p : {s.graph_path, s.clustering_path, s.ground_truth_path})
+    {
+        if (!p.empty() && !std::experimental::filesystem::exists(p))
+        {
+            std::cerr << "[ERROR] File " << p << " does not exist.\n";
+            return false;
+        }
+    }
+    return !s.graph_path.empty() && !s.clustering_path.empty();
+}
+
+/**
+ * @brief Entropy term -w log2(w / n) of a count w out of n.
+*/
+double h(const double w, const double n)
+{
+    return w > 0 ? -w * std::log2(w / n) : 0;
+}
+
+/**
+ * @brief Clusters of a clustering in increasing id order.
+*/
+std::vector<const Cluster*> clusters_of(const Clustering &clustering)
+{
+    std::vector<std::pair<unsigned int, const Cluster*>> id_clsts;
+    for (const auto &c : clustering)
+    {
+        id_clsts.emplace_back(c.first, &c.second);
+    }
+    std::sort(id_clsts.begin(), id_clsts.end());
+    std::vector<const Cluster*> clsts;
+    for (const auto &c : id_clsts)
+    {
+        clsts.push_back(c.second);
+    }
+    return clsts;
+}
+
+/**
+ * @brief Best match in clustering y of each cluster of clustering x (see
+ * best_matches). The intersections of a cluster of x with the clusters of y
+ * are counted through the clusters of each vertex (Clustering::get_v_belonging)
+ * in a dense array of each thread, so only the clusters of y that overlap it
+ * are visited. As in [2], H(X_i|Y_j) is only taken if the overlap is larger
+ * than the chance one, i.e., h(n11) + h(n00) > h(n01) + h(n10); a cluster
+ * without such a match has H(X_i|Y) = H(X_i).
+ * @param const Clustering &: clustering x.
+ * @param const Clustering &: clustering y.
+ * @param const unsigned int: number of vertices.
+ * @return best_matches: sums of the best matches of the clusters of x.
+*/
+best_matches match(const Clustering &x, const Clustering &y,
+    const unsigned int n)
+{
+    const auto x_clsts = clusters_of(x);
+    std::vector<unsigned int> y_size;
+    for (const auto &c : y)
+    {
+        y_size.resize(std::max<std::size_t>(y_size.size(), c.first + 1), 0);
+        y_size[c.first] = c.second.size();
+    }
+
+    const long long nb_clsts = static_cast<long long>(x_clsts.size());
+    double cond_entropy = 0;
+    double norm_cond_entropy = 0;
+    double f1 = 0;
+    double entropy = 0;
+    unsigned int nb_entropic = 0;
+    #pragma omp parallel reduction(+:cond_entropy, norm_cond_entropy, f1, \
+        entropy, nb_entropic)
+    {
+        std::vector<unsigned int> inter(y_size.size(), 0);
+        std::vector<unsigned int> touched;
+        #pragma omp for schedule(dynamic, 16)
+        for (long long i = 0; i < nb_clsts; ++i)
+        {
+            const Cluster &c = *x_clsts[i];
+            for (auto v : c)
+            {
+                auto row = y.get_v_belonging(v);
+                for (auto it = row.first; it != row.second; ++it)
+                {
+                    if (inter[*it]++ == 0)
+                    {
+                        touched.push_back(*it);
+                    }
+                }
+            }
+
+            const double a = c.size();
+            const double h_x = h(a, n) + h(n - a, n);
+            double best_h = h_x;
+            double best_f1 = 0;
+            for (auto j : touched)
+            {
+                const double b = y_size[j];
+                const double n11 = inter[j];
+                const double n10 = a - n11;
+                const double n01 = b - n11;
+                const double n00 = n - a - b + n11;
+                if (h(n11, n) + h(n00, n) > h(n01, n) + h(n10, n))
+                {
+                    best_h = std::min(best_h, h(n11, n) + h(n10, n) +
+                        h(n01, n) + h(n00, n) - h(b, n) - h(n - b, n));
+                }
+                best_f1 = std::max(best_f1, 2 * n11 / (a + b));
+                inter[j] = 0;
+            }
+            touched.clear();
+
+            cond_entropy += best_h / n;
+            entropy += h_x / n;
+            f1 += best_f1;
+            if (h_x > 0)
+            {
+                norm_cond_entropy += best_h / h_x;
+                ++nb_entropic;
+            }
+        }
+    }
+    return {cond_entropy, norm_cond_entropy, f1, entropy, nb_entropic};
+}
+
+/**
+ * @brief Print a metric and set it in the report.
+*/
+void output(Run_report &report, const std::string &name, const double val)
+{
+    std::printf("%-24s %.6g\n", name.c_str(), val);
+    report.set_field(name, std::to_string(val));
+}
+
+/**
+ * @brief Print a count and set it in the report (as an integer, not as a
+ * double like output()).
+*/
+void output_count(Run_report &report, const std::string &name,
+    const std::size_t val)
+{
+    std::printf("%-24s %zu\n", name.c_str(), val);
+    report.set_field(name, std::to_string(val));
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+int main(int argc, char** argv)
+{
+    settings s;
+    if (!set_settings(argc, argv, s))
+    {
+        std::cerr << "[ERROR] Wrong parameter. See the tools/quality.cpp file "
+            "header.\n";
+        return EXIT_FAILURE;
+    }
+    if (s.nb_threads > 0)
+    {
+        omp_set_num_threads(s.nb_threads);
+    }
+
+    Run_report report;
+    utils::time_mgmt tmgmt;
+    tmgmt.start();
+    const Graph g(s.graph_path, Graph::data_structure::adj_list);
+    tmgmt.end();
+    report.add_phase("graph_loading", tmgmt);
+    const unsigned int n = g.get_nb_vertices();
+
+    tmgmt.start();
+    const Clustering clustering(g, s.clustering_path);
+    tmgmt.end();
+    report.add_phase("clustering_loading", tmgmt);
+
+    // conductance of each cluster by its degrees bookkeeping
+    tmgmt.start();
+    const auto clsts = clusters_of(clustering);
+    const long long nb_clsts = static_cast<long long>(clsts.size());
+    std::vector<double> cond(clsts.size(), 1);
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (long long i = 0; i < nb_clsts; ++i)
+    {
+        cond[i] = utils::sweep::conductance(g.get_nb_edges(),
+            clsts[i]->get_volume(), clsts[i]->get_external_degree());
+    }
+
+    // coverage and memberships
+    const long long nb_vertices = static_cast<long long>(n);
+    unsigned long long nb_covered = 0;
+    unsigned long long nb_memberships = 0;
+    #pragma omp parallel for schedule(dynamic, 1024) \
+        reduction(+:nb_covered, nb_memberships)
+    for (long long v = 0; v < nb_vertices; ++v)
+    {
+        const unsigned int size = clustering.get_v_belonging_size(v);
+        nb_covered += size > 0;
+        nb_memberships += size;
+    }
+    tmgmt.end();
+    report.add_phase("conductance_and_coverage", tmgmt);
+
+    std::vector<double> sorted_cond = cond;
+    std::sort(sorted_cond.begin(), sorted_cond.end());
+    double sum_cond = 0;
+    for (auto c : cond)
+    {
+        sum_cond += c;
+    }
+
+    report.set_field("graph", Run_report::quote(s.graph_path));
+    report.set_field("clustering", Run_report::quote(s.clustering_path));
+    output_count(report, "nb_vertices", n);
+    output_count(report, "nb_edges", g.get_nb_edges());
+    output_count(report, "nb_clusters", clsts.size());
+    output(report, "avg_conductance", clsts.empty() ? 0 : sum_cond / clsts.size());
+    output(report, "median_conductance", clsts.empty() ? 0 :
+        sorted_cond[sorted_cond.size() / 2]);
+    output(report, "max_conductance", clsts.empty() ? 0 : sorted_cond.back());
+    output(report, "coverage", static_cast<double>(nb_covered) / n);
+    output(report, "avg_memberships", nb_covered == 0 ? 0 :
+        static_cast<double>(nb_memberships) / nb_covered);
+
+    if (!s.ground_truth_path.empty())
+    {
+        tmgmt.start();
+        const Clustering ground_truth(g, s.ground_truth_path);
+        tmgmt.end();
+        report.add_phase("ground_truth_loading", tmgmt);
+
+        tmgmt.start();
+        const best_matches xy = match(clustering, ground_truth, n);
+        const best_matches yx = match(ground_truth, clustering, n);
+        tmgmt.end();
+        report.add_phase("overlap_metrics", tmgmt);
+
+        // NMI of [1] and NMI_max of [2]
+        const double nmi_lfk = 1 - 0.5 *
+            ((xy.nb_clusters > 0 ? xy.norm_cond_entropy / xy.nb_clusters : 0) +
+            (yx.nb_clusters > 0 ? yx.norm_cond_entropy / yx.nb_clusters : 0));
+        const double mutual_info = 0.5 * (xy.entropy - xy.cond_entropy +
+            yx.entropy - yx.cond_entropy);
+        const double max_entropy = std::max(xy.entropy, yx.entropy);
+        output_count(report, "nb_ground_truth_clusters", ground_truth.size());
+        output(report, "nmi_lfk", nmi_lfk);
+        output(report, "nmi_max", max_entropy > 0 ?
+            mutual_info / max_entropy : 1);
+        // average F1 of [3]: mean of the best matches in both directions
+        const double f1_x = clsts.empty() ? 0 : xy.f1 / clsts.size();
+        const double f1_y = ground_truth.size() == 0 ? 0 :
+            yx.f1 / ground_truth.size();
+        output(report, "f1", 0.5 * (f1_x + f1_y));
+    }
+
+    if (!s.csv_path.empty())
+    {
+        std::ofstream csv(s.csv_path, std::fstream::trunc);
+        csv << "cluster,size,volume,cut,conductance\n";
+        for (std::size_t i = 0; i < clsts.size(); ++i)
+        {
+            csv << i << "," << clsts[i]->size() << "," <<
+                clsts[i]->get_volume() << "," <<
+                clsts[i]->get_external_degree() << "," << cond[i] << "\n";
+        }
+        csv.close();
+        if (!csv)
+        {
+            std::cerr << "[ERROR] It was not possible to write " << s.csv_path
+                << ".\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!s.report_path.empty() && !report.write(s.report_path))
+    {
+        std::cerr << "[ERROR] It was not possible to write " << s.report_path
+            << ".\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}